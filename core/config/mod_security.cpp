@@ -0,0 +1,289 @@
+/**************************************************************************/
+/*  mod_security.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "mod_security.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+
+void ModPathPolicy::add_rule(const String &p_prefix, RuleType p_type) {
+	Rule rule;
+	rule.prefix = p_prefix;
+	rule.type = p_type;
+	rules.push_back(rule);
+}
+
+void ModPathPolicy::clear_rules() {
+	rules.clear();
+}
+
+void ModPathPolicy::compile() {
+	// Build the trie with per-node edge lists first, then flatten it so every
+	// node's edges are contiguous and sorted for the lookup.
+	struct BuildNode {
+		LocalVector<Edge> edges;
+		int8_t rule = NO_RULE;
+	};
+	LocalVector<BuildNode> build;
+	build.push_back(BuildNode());
+
+	for (const Rule &rule : rules) {
+		uint32_t node = 0;
+		const char32_t *chars = rule.prefix.ptr();
+		for (int i = 0; i < rule.prefix.length(); i++) {
+			char32_t c = _fold(chars[i]);
+			uint32_t next = 0;
+			for (const Edge &edge : build[node].edges) {
+				if (edge.c == c) {
+					next = edge.node;
+					break;
+				}
+			}
+			if (next == 0) {
+				next = build.size();
+				build.push_back(BuildNode());
+				Edge edge;
+				edge.c = c;
+				edge.node = next;
+				build[node].edges.push_back(edge);
+			}
+			node = next;
+		}
+		build[node].rule = rule.type; // Later rules override earlier ones with the same prefix.
+	}
+
+	struct EdgeSort {
+		_FORCE_INLINE_ bool operator()(const Edge &p_a, const Edge &p_b) const { return p_a.c < p_b.c; }
+	};
+
+	nodes.resize(build.size());
+	edges.clear();
+	edges.reserve(build.size() - 1);
+	for (uint32_t i = 0; i < build.size(); i++) {
+		build[i].edges.sort_custom<EdgeSort>();
+		nodes[i].first_edge = edges.size();
+		nodes[i].edge_count = build[i].edges.size();
+		nodes[i].rule = build[i].rule;
+		for (const Edge &edge : build[i].edges) {
+			edges.push_back(edge);
+		}
+	}
+}
+
+int64_t ModPathPolicy::_find_edge(uint32_t p_node, char32_t p_char) const {
+	const Node &node = nodes[p_node];
+	uint32_t low = node.first_edge;
+	uint32_t high = node.first_edge + node.edge_count;
+	while (low < high) {
+		uint32_t middle = (low + high) / 2;
+		if (edges[middle].c < p_char) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	if (low < node.first_edge + node.edge_count && edges[low].c == p_char) {
+		return edges[low].node;
+	}
+	return -1;
+}
+
+bool ModPathPolicy::_has_parent_reference(const char32_t *p_path, int p_length) {
+	// Rules are plain prefixes, so "user://mods/../settings.cfg" must never reach them.
+	for (int i = 0; i + 1 < p_length; i++) {
+		if (p_path[i] == '.' && p_path[i + 1] == '.') {
+			bool starts_segment = i == 0 || p_path[i - 1] == '/' || p_path[i - 1] == '\\';
+			bool ends_segment = i + 2 == p_length || p_path[i + 2] == '/' || p_path[i + 2] == '\\';
+			if (starts_segment && ends_segment) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool ModPathPolicy::is_path_allowed(const String &p_path) const {
+	const char32_t *chars = p_path.ptr();
+	const int length = p_path.length();
+	if (nodes.is_empty() || _has_parent_reference(chars, length)) {
+		return false;
+	}
+
+	uint32_t node = 0;
+	int8_t verdict = nodes[0].rule;
+	int i = 0;
+	for (; i < length; i++) {
+		int64_t next = _find_edge(node, _fold(chars[i]));
+		if (next < 0) {
+			break;
+		}
+		node = next;
+		if (nodes[node].rule != NO_RULE) {
+			verdict = nodes[node].rule;
+		}
+	}
+
+	if (i == length) {
+		// The whole path was consumed: a directory rule also covers the directory itself.
+		int64_t dir = _find_edge(node, '/');
+		if (dir >= 0 && nodes[dir].rule != NO_RULE) {
+			verdict = nodes[dir].rule;
+		}
+	}
+
+	return verdict == RULE_ALLOW;
+}
+
+ModPathPolicy::ModPathPolicy() {
+	compile();
+}
+
+bool ModSandbox::reserve_quota(uint64_t p_bytes) {
+	if (quota == 0) {
+		quota_used.fetch_add(p_bytes, std::memory_order_relaxed);
+		return true;
+	}
+
+	uint64_t used = quota_used.load(std::memory_order_relaxed);
+	do {
+		if (p_bytes > quota - MIN(used, quota)) {
+			return false;
+		}
+	} while (!quota_used.compare_exchange_weak(used, used + p_bytes, std::memory_order_relaxed));
+
+	return true;
+}
+
+void ModSandbox::release_quota(uint64_t p_bytes) {
+	uint64_t used = quota_used.load(std::memory_order_relaxed);
+	while (!quota_used.compare_exchange_weak(used, used - MIN(used, p_bytes), std::memory_order_relaxed)) {
+	}
+}
+
+Ref<ModSandbox> ModSecurity::_get_legacy_sandbox() {
+	{
+		RWLockRead read_lock(policies_lock);
+		if (legacy_sandbox.is_valid()) {
+			return legacy_sandbox;
+		}
+	}
+
+	RWLockWrite write_lock(policies_lock);
+	if (legacy_sandbox.is_null()) {
+		// Game resources (res://, uid://), the rest of user:// and the
+		// filesystem are denied by default.
+		Ref<ModPathPolicy> policy;
+		policy.instantiate();
+		policy->add_rule("user://mods/", ModPathPolicy::RULE_ALLOW);
+		policy->compile();
+
+		Ref<ModSandbox> sandbox;
+		sandbox.instantiate();
+		sandbox->id = ++last_sandbox_id;
+		sandbox->root = "user://mods/";
+		sandbox->policy = policy;
+		legacy_sandbox = sandbox;
+	}
+	return legacy_sandbox;
+}
+
+// Raw access on purpose: the sandbox isn't active yet and mounted mod files don't take up storage.
+static uint64_t _get_directory_size(const String &p_dir) {
+	Ref<DirAccess> da = DirAccess::create_for_path(p_dir);
+	if (da.is_null() || da->change_dir(p_dir) != OK) {
+		return 0;
+	}
+	da->set_include_hidden(true);
+
+	uint64_t size = 0;
+	da->list_dir_begin();
+	for (String name = da->get_next(); !name.is_empty(); name = da->get_next()) {
+		String path = p_dir.path_join(name);
+		if (da->current_is_dir()) {
+			if (!da->is_link(name)) {
+				size += _get_directory_size(path);
+			}
+		} else {
+			size += MAX(0, FileAccess::get_size(path));
+		}
+	}
+	da->list_dir_end();
+	return size;
+}
+
+Ref<ModSandbox> ModSecurity::create_sandbox(const String &p_mod, uint64_t p_quota) {
+	ERR_FAIL_COND_V_MSG(!p_mod.is_valid_filename(), Ref<ModSandbox>(), vformat("Invalid mod name for a sandbox: '%s'.", p_mod));
+
+	Ref<ModSandbox> sandbox;
+	sandbox.instantiate();
+	sandbox->id = ++last_sandbox_id;
+	sandbox->mod = p_mod;
+	sandbox->root = "user://mods/" + p_mod + "/";
+	sandbox->quota = p_quota;
+
+	sandbox->policy = get_mod_policy(p_mod);
+	if (sandbox->policy.is_null()) {
+		Ref<ModPathPolicy> policy;
+		policy.instantiate();
+		policy->add_rule(sandbox->root, ModPathPolicy::RULE_ALLOW);
+		policy->compile();
+		sandbox->policy = policy;
+	}
+
+	// Files written by earlier runs still count, or every run would get a full quota again.
+	sandbox->quota_used.store(_get_directory_size(sandbox->root), std::memory_order_relaxed);
+	return sandbox;
+}
+
+void ModSecurity::set_mod_context(bool p_active) {
+	current_sandbox = p_active ? _get_legacy_sandbox() : Ref<ModSandbox>();
+}
+
+void ModSecurity::set_mod_policy(const String &p_mod, const Ref<ModPathPolicy> &p_policy) {
+	RWLockWrite write_lock(policies_lock);
+	if (p_policy.is_valid()) {
+		p_policy->compile();
+		mod_policies[p_mod] = p_policy;
+	} else {
+		mod_policies.erase(p_mod);
+	}
+}
+
+Ref<ModPathPolicy> ModSecurity::get_mod_policy(const String &p_mod) {
+	RWLockRead read_lock(policies_lock);
+	HashMap<String, Ref<ModPathPolicy>>::ConstIterator E = mod_policies.find(p_mod);
+	return E ? E->value : Ref<ModPathPolicy>();
+}
+
+void ModSecurity::clear_mod_policies() {
+	RWLockWrite write_lock(policies_lock);
+	mod_policies.clear();
+	legacy_sandbox.unref();
+}
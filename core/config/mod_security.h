@@ -27,18 +27,135 @@
 /* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
 /**************************************************************************/
-
 #pragma once
 
+#include "core/object/ref_counted.h"
+#include "core/os/rw_lock.h"
 #include "core/string/ustring.h"
-#include "core/templates/vector.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include <atomic>
+
+// Prefix rules deciding which paths code running in a mod context may touch.
+// Rules are compiled into a case-folded trie, so a check walks the raw
+// characters of the path once and never allocates. The longest matching
+// rule wins; paths matching no rule are denied.
+class ModPathPolicy : public RefCounted {
+	GDSOFTCLASS(ModPathPolicy, RefCounted);
+
+public:
+	enum RuleType {
+		RULE_DENY,
+		RULE_ALLOW,
+	};
+
+private:
+	struct Rule {
+		String prefix;
+		RuleType type = RULE_DENY;
+	};
+
+	static constexpr int8_t NO_RULE = -1;
+
+	struct Node {
+		uint32_t first_edge = 0;
+		uint32_t edge_count = 0;
+		int8_t rule = NO_RULE;
+	};
+
+	struct Edge {
+		char32_t c = 0;
+		uint32_t node = 0;
+	};
+
+	LocalVector<Rule> rules;
+
+	// Compiled form. Edges of a node are contiguous and sorted by character.
+	LocalVector<Node> nodes;
+	LocalVector<Edge> edges;
+
+	_FORCE_INLINE_ static char32_t _fold(char32_t p_char) {
+		if (p_char < 128) {
+			if (p_char >= 'A' && p_char <= 'Z') {
+				return p_char + ('a' - 'A');
+			}
+			return p_char == '\\' ? '/' : p_char;
+		}
+		return String::char_lowercase(p_char);
+	}
+
+	int64_t _find_edge(uint32_t p_node, char32_t p_char) const;
+	static bool _has_parent_reference(const char32_t *p_path, int p_length);
+
+public:
+	// Paths are matched by prefix. A rule ending in '/' also matches the
+	// directory itself, e.g. "user://mods/" matches "user://mods".
+	void add_rule(const String &p_prefix, RuleType p_type);
+	void clear_rules();
+	void compile();
+
+	bool is_path_allowed(const String &p_path) const;
+
+	ModPathPolicy();
+};
+
+// Identity, root directory and write quota of one running mod. Sandboxes are
+// immutable apart from the quota counter, so they can be shared freely
+// between the threads doing work on behalf of the mod.
+class ModSandbox : public RefCounted {
+	GDSOFTCLASS(ModSandbox, RefCounted);
+
+	friend class ModSecurity;
+
+	uint32_t id = 0;
+	String mod;
+	String root;
+	Ref<ModPathPolicy> policy;
+	uint64_t quota = 0; // Bytes; 0 means unlimited.
+	std::atomic<uint64_t> quota_used = 0;
+
+public:
+	uint32_t get_id() const { return id; }
+	const String &get_mod() const { return mod; }
+	const String &get_root() const { return root; }
+	const Ref<ModPathPolicy> &get_policy() const { return policy; }
+
+	uint64_t get_quota() const { return quota; }
+	uint64_t get_quota_used() const { return quota_used.load(std::memory_order_relaxed); }
+	// Charges bytes about to be written; fails without charging if they don't fit.
+	bool reserve_quota(uint64_t p_bytes);
+	void release_quota(uint64_t p_bytes);
+};
 
 class ModSecurity {
 private:
-	static inline thread_local bool mod_context_active = false;
+	static inline thread_local Ref<ModSandbox> current_sandbox;
 	static inline bool restrictions_enabled = false;
 
+	static inline Ref<ModSandbox> legacy_sandbox;
+	static inline HashMap<String, Ref<ModPathPolicy>> mod_policies;
+	static inline RWLock policies_lock;
+	static inline std::atomic<uint32_t> last_sandbox_id = 0;
+
+	static Ref<ModSandbox> _get_legacy_sandbox();
+
 public:
+	// Makes `p_sandbox` current on this thread for the lifetime of the scope,
+	// then restores whatever was current before. A null sandbox leaves mod context.
+	class Scope {
+		Ref<ModSandbox> previous;
+
+	public:
+		Scope(const Ref<ModSandbox> &p_sandbox) :
+				previous(current_sandbox) {
+			current_sandbox = p_sandbox;
+		}
+		~Scope() {
+			current_sandbox = previous;
+		}
+	};
+
 	// Enable/disable mod restrictions globally
 	static void set_restrictions_enabled(bool p_enabled) {
 		restrictions_enabled = p_enabled;
@@ -48,15 +165,31 @@ public:
 		return restrictions_enabled;
 	}
 
-	// Set whether current thread is executing mod code
-	static void set_mod_context(bool p_active) {
-		mod_context_active = p_active;
+	// Creates a sandbox rooted at `user://mods/<mod>/`. The mod's registered
+	// policy is used if there is one, otherwise only the root is accessible.
+	// Files already under the root are charged to the quota up front.
+	static Ref<ModSandbox> create_sandbox(const String &p_mod, uint64_t p_quota = 0);
+
+	// Sandbox of the mod the current thread works for, if any. Captured by
+	// WorkerThreadPool tasks and threaded resource loads when they are queued.
+	static const Ref<ModSandbox> &get_current_sandbox() {
+		return current_sandbox;
 	}
 
+	// Set whether current thread is executing mod code, sharing one sandbox
+	// over all of `user://mods/`. Prefer a Scope with a per-mod sandbox.
+	static void set_mod_context(bool p_active);
+
 	static bool is_in_mod_context() {
-		return mod_context_active && restrictions_enabled;
+		return restrictions_enabled && current_sandbox.is_valid();
 	}
 
+	// Policies are compiled when registered and must not be modified afterwards.
+	static void set_mod_policy(const String &p_mod, const Ref<ModPathPolicy> &p_policy);
+	static Ref<ModPathPolicy> get_mod_policy(const String &p_mod);
+	// Drops every registered policy and the shared legacy sandbox. Called on shutdown.
+	static void clear_mod_policies();
+
 	// Check if a path is allowed to be accessed from mod context
 	static bool is_path_allowed(const String &p_path) {
 		if (!is_in_mod_context()) {
@@ -64,30 +197,14 @@ public:
 			return true;
 		}
 
-		// In mod context with restrictions enabled
-		String path_lower = p_path.to_lower();
-
-		// Block access to res:// (game resources)
-		if (path_lower.begins_with("res://") || path_lower.begins_with("uid://")) {
-			return false;
-		}
-
-		// Only allow user://mods/ access
-		if (path_lower.begins_with("user://mods/") || path_lower == "user://mods") {
-			return true;
-		}
-
-		// Block all other user:// paths
-		if (path_lower.begins_with("user://")) {
-			return false;
-		}
-
-		// Block filesystem access
-		return false;
+		return current_sandbox->policy->is_path_allowed(p_path);
 	}
 
 	// Get a user-friendly error message for blocked access
 	static String get_access_denied_message(const String &p_path) {
+		if (current_sandbox.is_valid() && !current_sandbox->mod.is_empty()) {
+			return vformat("Mod security: Access denied to '%s'. Mod '%s' can only access '%s'.", p_path, current_sandbox->mod, current_sandbox->root);
+		}
 		return vformat("Mod security: Access denied to '%s'. Mods can only access 'user://mods/' directory.", p_path);
 	}
 };
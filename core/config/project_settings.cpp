@@ -35,6 +35,7 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_uid.h"
 #include "core/object/script_language.h"
@@ -565,8 +566,31 @@ bool ProjectSettings::load_resource_pack(const String &p_pack, bool p_replace_fi
 }
 
 bool ProjectSettings::_load_resource_pack(const String &p_pack, bool p_replace_files, int p_offset, bool p_main_pack) {
-	// PackedData support has been removed.
-	return false;
+	if (!PackedData::get_singleton() || PackedData::get_singleton()->is_disabled()) {
+		return false;
+	}
+
+	if (PackedData::get_singleton()->add_pack(p_pack, p_replace_files, p_offset) != OK) {
+		return false;
+	}
+
+	if (project_loaded) {
+		// This pack may have declared new global classes (make sure they are picked up).
+		refresh_global_class_list();
+
+		// This pack may have defined new UIDs, make sure they are cached.
+		ResourceUID::get_singleton()->load_from_cache(false);
+	}
+
+	// When the project itself comes from a pack, all directory access goes through it.
+	// Packs loaded on top of a project on disk only overlay files, so `res://` listings
+	// keep seeing the real project directory.
+	if (p_main_pack) {
+		DirAccess::make_default<DirAccessPack>(DirAccess::ACCESS_RESOURCES);
+		using_datapack = true;
+	}
+
+	return true;
 }
 
 void ProjectSettings::_convert_to_last_version(int p_from_version) {
@@ -32,6 +32,7 @@
 
 #include "core/config/mod_security.h"
 #include "core/config/project_settings.h"
+#include "core/io/dir_access_quota.h"
 #include "core/io/file_access.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
@@ -322,6 +323,15 @@ Ref<DirAccess> DirAccess::create(AccessType p_access) {
 		} else if (p_access == ACCESS_USERDATA) {
 			da->change_dir("user://");
 		}
+
+		// Files a sandboxed mod removes give their space back to its storage quota.
+		if (ModSecurity::is_in_mod_context() && ModSecurity::get_current_sandbox()->get_quota() > 0) {
+			Ref<DirAccessQuota> dq;
+			dq.instantiate();
+			dq->_access_type = p_access;
+			dq->set_base(da, ModSecurity::get_current_sandbox());
+			return dq;
+		}
 	}
 
 	return da;
@@ -0,0 +1,175 @@
+/**************************************************************************/
+/*  dir_access_quota.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "dir_access_quota.h"
+
+#include "core/io/file_access.h"
+
+uint64_t DirAccessQuota::_get_file_length(const String &p_path) {
+	if (!dir->file_exists(p_path)) {
+		return 0;
+	}
+
+	String path = p_path;
+	if (path.is_relative_path()) {
+		path = dir->get_current_dir().path_join(path);
+	}
+	int64_t length = FileAccess::get_size(path);
+	return length > 0 ? length : 0;
+}
+
+void DirAccessQuota::set_base(const Ref<DirAccess> &p_base, const Ref<ModSandbox> &p_sandbox) {
+	dir = p_base;
+	sandbox = p_sandbox;
+}
+
+Error DirAccessQuota::list_dir_begin() {
+	return dir->list_dir_begin();
+}
+
+String DirAccessQuota::get_next() {
+	return dir->get_next();
+}
+
+bool DirAccessQuota::current_is_dir() const {
+	return dir->current_is_dir();
+}
+
+bool DirAccessQuota::current_is_hidden() const {
+	return dir->current_is_hidden();
+}
+
+void DirAccessQuota::list_dir_end() {
+	dir->list_dir_end();
+}
+
+int DirAccessQuota::get_drive_count() {
+	return dir->get_drive_count();
+}
+
+String DirAccessQuota::get_drive(int p_drive) {
+	return dir->get_drive(p_drive);
+}
+
+int DirAccessQuota::get_current_drive() {
+	return dir->get_current_drive();
+}
+
+bool DirAccessQuota::drives_are_shortcuts() {
+	return dir->drives_are_shortcuts();
+}
+
+Error DirAccessQuota::change_dir(String p_dir) {
+	return dir->change_dir(p_dir);
+}
+
+String DirAccessQuota::get_current_dir(bool p_include_drive) const {
+	return dir->get_current_dir(p_include_drive);
+}
+
+Error DirAccessQuota::make_dir(String p_dir) {
+	return dir->make_dir(p_dir);
+}
+
+Error DirAccessQuota::make_dir_recursive(const String &p_dir) {
+	return dir->make_dir_recursive(p_dir);
+}
+
+bool DirAccessQuota::file_exists(String p_file) {
+	return dir->file_exists(p_file);
+}
+
+bool DirAccessQuota::dir_exists(String p_dir) {
+	return dir->dir_exists(p_dir);
+}
+
+bool DirAccessQuota::is_readable(String p_dir) {
+	return dir->is_readable(p_dir);
+}
+
+bool DirAccessQuota::is_writable(String p_dir) {
+	return dir->is_writable(p_dir);
+}
+
+uint64_t DirAccessQuota::get_space_left() {
+	return dir->get_space_left();
+}
+
+Error DirAccessQuota::copy(const String &p_from, const String &p_to, int p_chmod_flags) {
+	// The destination is written through FileAccess, which charges it.
+	return dir->copy(p_from, p_to, p_chmod_flags);
+}
+
+Error DirAccessQuota::rename(String p_from, String p_to) {
+	// A file replaced by the rename no longer takes any space.
+	uint64_t replaced_length = dir->is_equivalent(p_from, p_to) ? 0 : _get_file_length(p_to);
+	Error err = dir->rename(p_from, p_to);
+	if (err == OK) {
+		sandbox->release_quota(replaced_length);
+	}
+	return err;
+}
+
+Error DirAccessQuota::remove(String p_name) {
+	uint64_t removed_length = _get_file_length(p_name);
+	Error err = dir->remove(p_name);
+	if (err == OK) {
+		sandbox->release_quota(removed_length);
+	}
+	return err;
+}
+
+bool DirAccessQuota::is_link(String p_file) {
+	return dir->is_link(p_file);
+}
+
+String DirAccessQuota::read_link(String p_file) {
+	return dir->read_link(p_file);
+}
+
+Error DirAccessQuota::create_link(String p_source, String p_target) {
+	return dir->create_link(p_source, p_target);
+}
+
+String DirAccessQuota::get_filesystem_type() const {
+	return dir->get_filesystem_type();
+}
+
+bool DirAccessQuota::is_case_sensitive(const String &p_path) const {
+	return dir->is_case_sensitive(p_path);
+}
+
+bool DirAccessQuota::is_bundle(const String &p_file) const {
+	return dir->is_bundle(p_file);
+}
+
+bool DirAccessQuota::is_equivalent(const String &p_path_a, const String &p_path_b) const {
+	return dir->is_equivalent(p_path_a, p_path_b);
+}
@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*  dir_access_quota.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/mod_security.h"
+#include "core/io/dir_access.h"
+
+// Wrapper handing the space of files a sandboxed mod removes or replaces by
+// renaming back to its storage quota. Growth is charged by FileAccessQuota.
+class DirAccessQuota : public DirAccess {
+	GDSOFTCLASS(DirAccessQuota, DirAccess);
+
+	Ref<DirAccess> dir;
+	Ref<ModSandbox> sandbox;
+
+	uint64_t _get_file_length(const String &p_path);
+
+public:
+	void set_base(const Ref<DirAccess> &p_base, const Ref<ModSandbox> &p_sandbox);
+
+	virtual Error list_dir_begin() override;
+	virtual String get_next() override;
+	virtual bool current_is_dir() const override;
+	virtual bool current_is_hidden() const override;
+	virtual void list_dir_end() override;
+
+	virtual int get_drive_count() override;
+	virtual String get_drive(int p_drive) override;
+	virtual int get_current_drive() override;
+	virtual bool drives_are_shortcuts() override;
+
+	virtual Error change_dir(String p_dir) override;
+	virtual String get_current_dir(bool p_include_drive = true) const override;
+	virtual Error make_dir(String p_dir) override;
+	virtual Error make_dir_recursive(const String &p_dir) override;
+
+	virtual bool file_exists(String p_file) override;
+	virtual bool dir_exists(String p_dir) override;
+	virtual bool is_readable(String p_dir) override;
+	virtual bool is_writable(String p_dir) override;
+	virtual uint64_t get_space_left() override;
+
+	virtual Error copy(const String &p_from, const String &p_to, int p_chmod_flags = -1) override;
+	virtual Error rename(String p_from, String p_to) override;
+	virtual Error remove(String p_name) override;
+
+	virtual bool is_link(String p_file) override;
+	virtual String read_link(String p_file) override;
+	virtual Error create_link(String p_source, String p_target) override;
+
+	virtual String get_filesystem_type() const override;
+	virtual bool is_case_sensitive(const String &p_path) const override;
+	virtual bool is_bundle(const String &p_file) const override;
+	virtual bool is_equivalent(const String &p_path_a, const String &p_path_b) const override;
+};
@@ -36,6 +36,8 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/file_access_quota.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_uid.h"
 #include "core/os/os.h"
@@ -56,6 +58,10 @@ bool FileAccess::exists(const String &p_name) {
 		ERR_FAIL_V_MSG(false, ModSecurity::get_access_denied_message(p_name));
 	}
 
+	if (PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled() && PackedData::get_singleton()->has_path(p_name)) {
+		return true;
+	}
+
 	// Using file_exists because it's faster than trying to open the file.
 	Ref<FileAccess> ret = create_for_path(p_name);
 	return ret->file_exists(p_name);
@@ -164,14 +170,45 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 		ERR_FAIL_V_MSG(Ref<FileAccess>(), ModSecurity::get_access_denied_message(p_path));
 	}
 
+	// Try opening from packs and mounted archives first (read only).
+	if (p_mode_flags == READ && PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled()) {
+		Ref<FileAccess> fa = PackedData::get_singleton()->try_open_path(p_path);
+		if (fa.is_valid()) {
+			if (r_error) {
+				*r_error = OK;
+			}
+			return fa;
+		}
+	}
+
 	Ref<FileAccess> ret = create_for_path(p_path);
-	Error err = ret->open_internal(p_path, p_mode_flags & ~SKIP_PACK);
+
+	// Writes from a sandboxed mod count against its storage quota.
+	const Ref<ModSandbox> &sandbox = ModSecurity::get_current_sandbox();
+	const bool charge_quota = (p_mode_flags & WRITE) && ModSecurity::is_in_mod_context() && sandbox->get_quota() > 0;
+	const int mode_flags = p_mode_flags & ~SKIP_PACK;
+	uint64_t truncated_length = 0;
+	if (charge_quota && (mode_flags == WRITE || mode_flags == WRITE_READ) && ret->file_exists(p_path)) {
+		// Opening truncates the file, so what it held is handed back.
+		int64_t length = ret->_get_size(p_path);
+		truncated_length = length > 0 ? length : 0;
+	}
+
+	Error err = ret->open_internal(p_path, mode_flags);
 
 	if (r_error) {
 		*r_error = err;
 	}
 	if (err != OK) {
 		ret.unref();
+		return ret;
+	}
+
+	if (charge_quota) {
+		Ref<FileAccessQuota> fq;
+		fq.instantiate();
+		fq->open_and_charge(ret, sandbox, truncated_length);
+		return fq;
 	}
 
 	return ret;
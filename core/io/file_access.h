@@ -53,6 +53,12 @@ public:
 		ACCESS_MAX
 	};
 
+	enum AccessPattern : int32_t {
+		ACCESS_PATTERN_NORMAL,
+		ACCESS_PATTERN_SEQUENTIAL,
+		ACCESS_PATTERN_RANDOM,
+	};
+
 	enum ModeFlags : int32_t {
 		READ = 1,
 		WRITE = 2,
@@ -197,6 +203,13 @@ public:
 	String get_as_text() const;
 	virtual String get_as_utf8_string() const;
 
+	// Read-only view of the whole file, valid until the file is closed. Backends
+	// that can't provide one (or files not opened for reading) return nullptr.
+	// Backends that create the view on demand may serve later reads from it too.
+	virtual const uint8_t *get_mapped_buffer() { return nullptr; }
+	// Tells the OS how the file is going to be read, so it can adapt readahead.
+	virtual void set_access_pattern(AccessPattern p_pattern) {}
+
 	/**
 
 	 * Use this for files WRITTEN in _big_ endian machines (ie, amiga/mac)
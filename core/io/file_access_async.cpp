@@ -0,0 +1,244 @@
+/**************************************************************************/
+/*  file_access_async.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_async.h"
+
+#include "core/io/resource_importer.h"
+
+FileAccessAsync::RequestID FileAccessAsync::_submit_locked(const Read &p_read, bool p_prefetch) {
+	RequestID id = ++last_id;
+	Request &request = requests[id];
+	request.read = p_read;
+	request.sandbox = ModSecurity::get_current_sandbox();
+	request.prefetch = p_prefetch;
+	queue.push_back(id);
+	return id;
+}
+
+void FileAccessAsync::_start_threads() {
+#ifdef THREADS_ENABLED
+	// Started on first use, most tools never read asynchronously.
+	if (!threads.is_empty() || exiting) {
+		return;
+	}
+	for (uint32_t i = 0; i < thread_count; i++) {
+		Thread *thread = memnew(Thread);
+		thread->start(&FileAccessAsync::_thread_function, this);
+		threads.push_back(thread);
+	}
+#else
+	// Without threads, requests complete before being handed back.
+	Ref<FileAccess> file;
+	String file_path;
+	LocalVector<uint8_t> scratch;
+	while (!queue.is_empty()) {
+		RequestID id = queue.front()->get();
+		queue.pop_front();
+		Request &request = requests[id];
+		_process(request, file, file_path, scratch);
+		if (request.prefetch) {
+			requests.erase(id);
+		} else {
+			request.completed = true;
+		}
+	}
+#endif
+}
+
+void FileAccessAsync::_process(Request &r_request, Ref<FileAccess> &r_file, String &r_file_path, LocalVector<uint8_t> &r_scratch) {
+	ModSecurity::Scope sandbox_scope(r_request.sandbox);
+
+	String path = r_request.read.path;
+	if (r_request.prefetch && ResourceFormatImporter::get_singleton() && FileAccess::exists(path + ".import")) {
+		String internal_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(path);
+		if (!internal_path.is_empty()) {
+			path = internal_path;
+		}
+	}
+
+	// Consecutive reads of the same file, common in a batch, reuse the handle.
+	// Files opened in another sandbox are not, the new one may not be allowed in.
+	String file_key = path + "|" + itos((int64_t)r_request.sandbox.ptr());
+	if (r_file.is_null() || r_file_path != file_key) {
+		Error err = OK;
+		r_file = FileAccess::open(path, FileAccess::READ, &err);
+		if (r_file.is_null()) {
+			r_file_path = String();
+			r_request.error = err;
+			return;
+		}
+		r_file_path = file_key;
+	}
+
+	if (r_request.prefetch) {
+		r_file->set_access_pattern(FileAccess::ACCESS_PATTERN_SEQUENTIAL);
+		r_file->seek(0);
+		r_scratch.resize(65536);
+		while (r_file->get_buffer(r_scratch.ptr(), r_scratch.size()) == r_scratch.size()) {
+		}
+		return;
+	}
+
+	r_file->seek(r_request.read.offset);
+	r_request.bytes_read = r_file->get_buffer(r_request.read.buffer, r_request.read.length);
+	r_request.error = r_request.bytes_read < r_request.read.length ? ERR_FILE_EOF : OK;
+}
+
+void FileAccessAsync::_thread_function(void *p_user) {
+	FileAccessAsync *self = static_cast<FileAccessAsync *>(p_user);
+	Thread::set_name("FileAccessAsync");
+
+	Ref<FileAccess> file;
+	String file_path;
+	LocalVector<uint8_t> scratch;
+
+	MutexLock lock(self->mutex);
+	while (true) {
+		if (self->queue.is_empty()) {
+			if (file.is_valid()) {
+				// Don't keep files open while idle.
+				lock.temp_unlock();
+				file.unref();
+				file_path = String();
+				lock.temp_relock();
+				continue;
+			}
+			if (self->exiting) {
+				break;
+			}
+			self->queued_cond.wait(lock);
+			continue;
+		}
+
+		RequestID id = self->queue.front()->get();
+		self->queue.pop_front();
+		Request request = self->requests[id];
+
+		lock.temp_unlock();
+		_process(request, file, file_path, scratch);
+		lock.temp_relock();
+
+		if (request.prefetch) {
+			self->requests.erase(id);
+			continue;
+		}
+		Request *pending = self->requests.getptr(id);
+		if (pending) {
+			pending->completed = true;
+			pending->error = request.error;
+			pending->bytes_read = request.bytes_read;
+		}
+		self->completed_cond.notify_all();
+	}
+}
+
+FileAccessAsync::RequestID FileAccessAsync::submit(const Read &p_read) {
+	RequestID id = INVALID_REQUEST_ID;
+	submit_batch(&p_read, 1, &id);
+	return id;
+}
+
+void FileAccessAsync::submit_batch(const Read *p_reads, uint32_t p_count, RequestID *r_ids) {
+	ERR_FAIL_COND(p_count > 0 && (!p_reads || !r_ids));
+
+	MutexLock lock(mutex);
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Read &read = p_reads[i];
+		if (exiting || read.path.is_empty() || (read.length > 0 && !read.buffer)) {
+			ERR_PRINT(vformat("Invalid asynchronous read of '%s'.", read.path));
+			r_ids[i] = INVALID_REQUEST_ID;
+			continue;
+		}
+		r_ids[i] = _submit_locked(read, false);
+	}
+	_start_threads();
+	queued_cond.notify_all();
+}
+
+bool FileAccessAsync::is_completed(RequestID p_id) {
+	MutexLock lock(mutex);
+	const Request *request = requests.getptr(p_id);
+	ERR_FAIL_NULL_V_MSG(request, true, "Invalid or already released asynchronous read.");
+	return request->completed;
+}
+
+Error FileAccessAsync::wait(RequestID p_id, uint64_t *r_bytes_read) {
+	MutexLock lock(mutex);
+	ERR_FAIL_COND_V_MSG(!requests.has(p_id), ERR_INVALID_PARAMETER, "Invalid or already released asynchronous read.");
+
+	while (!requests[p_id].completed) {
+		completed_cond.wait(lock);
+	}
+
+	const Request &request = requests[p_id];
+	Error err = request.error;
+	if (r_bytes_read) {
+		*r_bytes_read = request.bytes_read;
+	}
+	requests.erase(p_id);
+	return err;
+}
+
+void FileAccessAsync::prefetch(const String &p_path) {
+	MutexLock lock(mutex);
+	if (exiting) {
+		return;
+	}
+	Read read;
+	read.path = p_path;
+	_submit_locked(read, true);
+	_start_threads();
+	queued_cond.notify_one();
+}
+
+void FileAccessAsync::finish() {
+	{
+		MutexLock lock(mutex);
+		exiting = true;
+		queued_cond.notify_all();
+	}
+
+	// Threads drain the queue before exiting, so nobody waits forever.
+	for (Thread *thread : threads) {
+		thread->wait_to_finish();
+		memdelete(thread);
+	}
+	threads.clear();
+}
+
+FileAccessAsync::FileAccessAsync(uint32_t p_thread_count) {
+	thread_count = MAX(1u, p_thread_count);
+	singleton = this;
+}
+
+FileAccessAsync::~FileAccessAsync() {
+	finish();
+	singleton = nullptr;
+}
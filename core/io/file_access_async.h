@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  file_access_async.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/mod_security.h"
+#include "core/io/file_access.h"
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+
+// Queue of file reads served by a few dedicated I/O threads, so threads that
+// have other work to do don't block on the disk. Reads go through FileAccess,
+// so packs, mounted mods and sandboxes behave exactly as for a synchronous
+// read; each request runs in the mod sandbox that submitted it.
+//
+// Submitting many reads at once keeps the device queue full. Requests must be
+// waited for, which also releases them; prefetches are fire and forget.
+class FileAccessAsync {
+public:
+	typedef int64_t RequestID;
+
+	enum {
+		INVALID_REQUEST_ID = -1,
+		DEFAULT_THREAD_COUNT = 4,
+	};
+
+	struct Read {
+		String path;
+		uint64_t offset = 0;
+		uint64_t length = 0;
+		uint8_t *buffer = nullptr; // Must stay valid until the request is waited for.
+	};
+
+private:
+	struct Request {
+		Read read;
+		Ref<ModSandbox> sandbox;
+		bool prefetch = false;
+		bool completed = false;
+		Error error = OK;
+		uint64_t bytes_read = 0;
+	};
+
+	static inline FileAccessAsync *singleton = nullptr;
+
+	BinaryMutex mutex;
+	ConditionVariable queued_cond;
+	ConditionVariable completed_cond;
+	HashMap<RequestID, Request> requests;
+	List<RequestID> queue;
+	RequestID last_id = 0;
+
+	LocalVector<Thread *> threads;
+	uint32_t thread_count = DEFAULT_THREAD_COUNT;
+	bool exiting = false;
+
+	RequestID _submit_locked(const Read &p_read, bool p_prefetch);
+	void _start_threads();
+	static void _thread_function(void *p_user);
+	static void _process(Request &r_request, Ref<FileAccess> &r_file, String &r_file_path, LocalVector<uint8_t> &r_scratch);
+
+public:
+	static FileAccessAsync *get_singleton() { return singleton; }
+
+	RequestID submit(const Read &p_read);
+	// Submits all reads before any thread picks them up, `r_ids` receives one ID per read.
+	void submit_batch(const Read *p_reads, uint32_t p_count, RequestID *r_ids);
+
+	bool is_completed(RequestID p_id);
+	// Blocks until the read is done and releases the request.
+	Error wait(RequestID p_id, uint64_t *r_bytes_read = nullptr);
+
+	// Reads the file in the background so a later read finds it in the OS cache.
+	// Imported resources are resolved to the file they're loaded from.
+	void prefetch(const String &p_path);
+
+	void finish();
+
+	FileAccessAsync(uint32_t p_thread_count = DEFAULT_THREAD_COUNT);
+	~FileAccessAsync();
+};
@@ -0,0 +1,666 @@
+/**************************************************************************/
+/*  file_access_pack.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#include "file_access_pack.h"
+
+#include "core/io/file_access_encrypted.h"
+#include "core/object/script_language.h"
+#include "core/version.h"
+
+void PackedData::add_pack_source(PackSource *p_source) {
+	if (p_source != nullptr) {
+		sources.push_back(p_source);
+	}
+}
+
+void PackedData::_add_to_tree(const String &p_path) {
+	if (!p_path.begins_with("res://")) {
+		return;
+	}
+
+	String rel = p_path.trim_prefix("res://");
+	Vector<String> ds = rel.get_base_dir().split("/", false);
+
+	PackedDir *cd = root;
+	for (const String &d : ds) {
+		HashMap<String, PackedDir *>::Iterator E = cd->subdirs.find(d);
+		if (E) {
+			cd = E->value;
+		} else {
+			PackedDir *pd = memnew(PackedDir);
+			pd->name = d;
+			pd->parent = cd;
+			cd->subdirs[d] = pd;
+			cd = pd;
+		}
+	}
+	cd->files.insert(rel.get_file());
+}
+
+void PackedData::_remove_from_tree(const String &p_path) {
+	if (!p_path.begins_with("res://")) {
+		return;
+	}
+
+	String rel = p_path.trim_prefix("res://");
+	PackedDir *cd = const_cast<PackedDir *>(_find_dir(rel.get_base_dir()));
+	if (!cd) {
+		return;
+	}
+
+	cd->files.erase(rel.get_file());
+
+	// Prune directories that only existed because of the removed file.
+	while (cd != root && cd->files.is_empty() && cd->subdirs.is_empty()) {
+		PackedDir *parent = cd->parent;
+		parent->subdirs.erase(cd->name);
+		memdelete(cd);
+		cd = parent;
+	}
+}
+
+const PackedData::PackedDir *PackedData::_find_dir(const String &p_dir) const {
+	const PackedDir *cd = root;
+	for (const String &d : p_dir.split("/", false)) {
+		HashMap<String, PackedDir *>::ConstIterator E = cd->subdirs.find(d);
+		if (!E) {
+			return nullptr;
+		}
+		cd = E->value;
+	}
+	return cd;
+}
+
+void PackedData::_free_packed_dirs(PackedDir *p_dir) {
+	for (const KeyValue<String, PackedDir *> &E : p_dir->subdirs) {
+		_free_packed_dirs(E.value);
+	}
+	memdelete(p_dir);
+}
+
+void PackedData::add_path(const String &p_pack_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle) {
+	String path = _normalize_path(p_path);
+
+	PackedFile pf;
+	pf.pack = p_pack_path;
+	pf.offset = p_ofs;
+	pf.size = p_size;
+	pf.src = p_src;
+	pf.encrypted = p_encrypted;
+	pf.bundle = p_bundle;
+
+	RWLockWrite write_lock(files_lock);
+	HashMap<String, PackedFile>::Iterator E = files.find(path);
+	if (!E) {
+		files.insert(path, pf);
+		_add_to_tree(path);
+		return;
+	}
+
+	if (!p_replace_files) {
+		return;
+	}
+
+	if (E->value.pack != p_pack_path) {
+		// Keep the overridden entry so it comes back if this pack is removed.
+		shadowed[path].push_back(E->value);
+	}
+	E->value = pf;
+}
+
+void PackedData::remove_path(const String &p_path) {
+	String path = _normalize_path(p_path);
+
+	RWLockWrite write_lock(files_lock);
+	if (files.erase(path)) {
+		shadowed.erase(path);
+		_remove_from_tree(path);
+	}
+}
+
+void PackedData::remove_pack(const String &p_pack_path) {
+	RWLockWrite write_lock(files_lock);
+
+	// Drop the hidden entries of this pack first, so they can't resurface below.
+	LocalVector<String> empty_stacks;
+	for (KeyValue<String, LocalVector<PackedFile>> &E : shadowed) {
+		LocalVector<PackedFile> &stack = E.value;
+		for (uint32_t i = stack.size(); i > 0; i--) {
+			if (stack[i - 1].pack == p_pack_path) {
+				stack.remove_at(i - 1);
+			}
+		}
+		if (stack.is_empty()) {
+			empty_stacks.push_back(E.key);
+		}
+	}
+	for (const String &path : empty_stacks) {
+		shadowed.erase(path);
+	}
+
+	LocalVector<String> to_remove;
+	for (const KeyValue<String, PackedFile> &E : files) {
+		if (E.value.pack == p_pack_path) {
+			to_remove.push_back(E.key);
+		}
+	}
+
+	for (const String &path : to_remove) {
+		HashMap<String, LocalVector<PackedFile>>::Iterator S = shadowed.find(path);
+		if (S) {
+			// Restore the entry this pack was overriding.
+			files[path] = S->value[S->value.size() - 1];
+			S->value.remove_at(S->value.size() - 1);
+			if (S->value.is_empty()) {
+				shadowed.remove(S);
+			}
+		} else {
+			files.erase(path);
+			_remove_from_tree(path);
+		}
+	}
+}
+
+void PackedData::reserve(uint32_t p_file_count) {
+	RWLockWrite write_lock(files_lock);
+	files.reserve(files.size() + p_file_count);
+}
+
+Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	for (PackSource *source : sources) {
+		if (source->try_open_pack(p_path, p_replace_files, p_offset)) {
+			return OK;
+		}
+	}
+
+	return ERR_FILE_UNRECOGNIZED;
+}
+
+Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
+	PackedFile pf;
+	{
+		RWLockRead read_lock(files_lock);
+		if (files.is_empty()) {
+			return Ref<FileAccess>();
+		}
+
+		HashMap<String, PackedFile>::ConstIterator E = files.find(_normalize_path(p_path));
+		if (!E) {
+			return Ref<FileAccess>(); // Not found.
+		}
+		pf = E->value;
+	}
+
+	return pf.src->get_file(p_path, &pf);
+}
+
+bool PackedData::has_path(const String &p_path) {
+	RWLockRead read_lock(files_lock);
+	if (files.is_empty()) {
+		return false;
+	}
+	return files.has(_normalize_path(p_path));
+}
+
+bool PackedData::has_directory(const String &p_dir) const {
+	RWLockRead read_lock(files_lock);
+	return _find_dir(p_dir) != nullptr;
+}
+
+bool PackedData::get_directory_contents(const String &p_dir, LocalVector<String> &r_dirs, LocalVector<String> &r_files) const {
+	RWLockRead read_lock(files_lock);
+	const PackedDir *pd = _find_dir(p_dir);
+	if (!pd) {
+		return false;
+	}
+
+	for (const KeyValue<String, PackedDir *> &E : pd->subdirs) {
+		r_dirs.push_back(E.key);
+	}
+	for (const String &file : pd->files) {
+		r_files.push_back(file);
+	}
+	return true;
+}
+
+PackedData::PackedData() {
+	singleton = this;
+	root = memnew(PackedDir);
+
+	add_pack_source(memnew(PackedSourcePCK));
+}
+
+PackedData::~PackedData() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+
+	for (PackSource *source : sources) {
+		memdelete(source);
+	}
+	_free_packed_dirs(root);
+}
+
+//////////////////////////////////////////////////////////////////
+
+bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	bool pck_header_found = false;
+
+	// Search for the header at the start offset - standalone PCK file.
+	f->seek(p_offset);
+	uint32_t magic = f->get_32();
+	if (magic == PACK_HEADER_MAGIC) {
+		pck_header_found = true;
+	}
+
+	// Search for the header at the end of file - self-contained executable.
+	if (!pck_header_found) {
+		// Loading with offset feature not supported for self-contained exe files.
+		if (p_offset != 0) {
+			ERR_FAIL_V_MSG(false, "Loading self-contained executable with offset not supported.");
+		}
+
+		uint64_t length = f->get_length();
+		if (length < 16) {
+			return false;
+		}
+
+		f->seek(length - 4);
+		magic = f->get_32();
+		if (magic == PACK_HEADER_MAGIC) {
+			f->seek(length - 12);
+			uint64_t ds = f->get_64();
+			if (ds + 12 <= length) {
+				f->seek(length - 12 - ds);
+				magic = f->get_32();
+				if (magic == PACK_HEADER_MAGIC) {
+					pck_header_found = true;
+				}
+			}
+		}
+	}
+
+	if (!pck_header_found) {
+		return false;
+	}
+
+	int64_t pck_start_pos = f->get_position() - 4;
+
+	uint32_t version = f->get_32();
+	uint32_t ver_major = f->get_32();
+	uint32_t ver_minor = f->get_32();
+	f->get_32(); // Patch number, not used for validation.
+
+	ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION_V2 || version > PACK_FORMAT_VERSION_V3, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.", ver_major, ver_minor));
+
+	uint32_t pack_flags = f->get_32();
+	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE);
+	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
+
+	uint64_t file_base = f->get_64();
+	if (version == PACK_FORMAT_VERSION_V3 || rel_filebase) {
+		file_base += pck_start_pos;
+	}
+
+	if (version == PACK_FORMAT_VERSION_V3) {
+		// V3: Read directory offset and skip reserved part of the header.
+		uint64_t dir_offset = f->get_64() + pck_start_pos;
+		f->seek(dir_offset);
+	} else {
+		// V2: Directory directly after the header.
+		for (int i = 0; i < 16; i++) {
+			f->get_32(); // Reserved.
+		}
+	}
+
+	Ref<FileAccess> fd = f;
+	if (enc_directory) {
+		Ref<FileAccessEncrypted> fae;
+		fae.instantiate();
+
+		Vector<uint8_t> key;
+		key.resize(32);
+		for (int i = 0; i < key.size(); i++) {
+			key.write[i] = script_encryption_key[i];
+		}
+
+		Error err = fae->open_and_parse(f, key, FileAccessEncrypted::MODE_READ, false);
+		ERR_FAIL_COND_V_MSG(err, false, "Can't open encrypted pack directory.");
+		fd = fae;
+	}
+
+	uint32_t file_count = fd->get_32();
+	PackedData::get_singleton()->reserve(file_count);
+
+	for (uint32_t i = 0; i < file_count; i++) {
+		uint32_t sl = fd->get_32();
+		CharString cs;
+		cs.resize_uninitialized(sl + 1);
+		fd->get_buffer((uint8_t *)cs.ptr(), sl);
+		cs.ptrw()[sl] = 0;
+
+		String path = String::utf8(cs.ptr(), sl);
+		if (!path.contains("://")) {
+			path = "res://" + path;
+		}
+
+		uint64_t ofs = fd->get_64();
+		uint64_t size = fd->get_64();
+		uint8_t md5[16];
+		fd->get_buffer(md5, 16);
+		uint32_t flags = fd->get_32();
+		ERR_FAIL_COND_V_MSG(fd->eof_reached(), false, vformat("Pack directory of '%s' is truncated.", p_path));
+
+		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
+			PackedData::get_singleton()->remove_path(path);
+		} else {
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle);
+		}
+	}
+
+	// Keep the descriptor open for the lifetime of the pack, so opening a file
+	// inside it doesn't go back to the OS. Files already open from a previous
+	// load of the same path keep a reference to the old handle.
+	Ref<Pack> pack;
+	pack.instantiate();
+	pack->file = f;
+	pack->data = f->get_mapped_buffer();
+	pack->length = f->get_length();
+
+	MutexLock lock(packs_mutex);
+	packs[p_path] = pack;
+
+	return true;
+}
+
+Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (p_file->bundle) {
+		String simplified_path = p_path.simplify_path().trim_prefix("res://");
+		return FileAccess::open(p_file->pack.get_base_dir().path_join(simplified_path), FileAccess::READ | FileAccess::SKIP_PACK);
+	}
+
+	Ref<Pack> pack;
+	{
+		MutexLock lock(packs_mutex);
+		HashMap<String, Ref<Pack>>::Iterator E = packs.find(p_file->pack);
+		ERR_FAIL_COND_V_MSG(!E, Ref<FileAccess>(), vformat("Pack '%s' is not open.", p_file->pack));
+		pack = E->value;
+	}
+
+	ERR_FAIL_COND_V_MSG(p_file->offset + p_file->size > pack->length, Ref<FileAccess>(), vformat("File '%s' lies outside of pack '%s'.", p_path, p_file->pack));
+
+	Ref<FileAccess> fa = memnew(FileAccessPack(p_path, *p_file, pack));
+	if (!p_file->encrypted) {
+		return fa;
+	}
+
+	Ref<FileAccessEncrypted> fae;
+	fae.instantiate();
+
+	Vector<uint8_t> key;
+	key.resize(32);
+	for (int i = 0; i < key.size(); i++) {
+		key.write[i] = script_encryption_key[i];
+	}
+
+	Error err = fae->open_and_parse(fa, key, FileAccessEncrypted::MODE_READ, false);
+	ERR_FAIL_COND_V_MSG(err, Ref<FileAccess>(), vformat("Can't open encrypted pack-referenced file '%s'.", p_path));
+	return fae;
+}
+
+//////////////////////////////////////////////////////////////////
+
+Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
+	ERR_PRINT("Can't open pack-referenced file.");
+	return ERR_UNAVAILABLE;
+}
+
+bool FileAccessPack::is_open() const {
+	return pack.is_valid();
+}
+
+void FileAccessPack::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(pack.is_null(), "File must be opened before use.");
+
+	if (p_position > pf.size) {
+		eof = true;
+	} else {
+		eof = false;
+	}
+
+	pos = p_position;
+}
+
+void FileAccessPack::seek_end(int64_t p_position) {
+	seek(pf.size + p_position);
+}
+
+uint64_t FileAccessPack::get_position() const {
+	return pos;
+}
+
+uint64_t FileAccessPack::get_length() const {
+	return pf.size;
+}
+
+bool FileAccessPack::eof_reached() const {
+	return eof;
+}
+
+uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+	ERR_FAIL_COND_V_MSG(pack.is_null(), -1, "File must be opened before use.");
+
+	if (eof) {
+		return 0;
+	}
+
+	uint64_t to_read = p_length;
+	if (pos >= pf.size) {
+		to_read = 0;
+		eof = true;
+	} else if (to_read > pf.size - pos) {
+		to_read = pf.size - pos;
+		eof = true;
+	}
+
+	if (to_read == 0) {
+		return 0;
+	}
+
+	if (data) {
+		memcpy(p_dst, data + pos, to_read);
+	} else {
+		MutexLock lock(pack->mutex);
+		pack->file->seek(pf.offset + pos);
+		to_read = pack->file->get_buffer(p_dst, to_read);
+	}
+
+	pos += to_read;
+	return to_read;
+}
+
+Error FileAccessPack::get_error() const {
+	if (eof) {
+		return ERR_FILE_EOF;
+	}
+	return OK;
+}
+
+void FileAccessPack::flush() {
+	ERR_FAIL();
+}
+
+bool FileAccessPack::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_V(false);
+}
+
+bool FileAccessPack::file_exists(const String &p_name) {
+	return false;
+}
+
+void FileAccessPack::close() {
+	pack.unref();
+	data = nullptr;
+}
+
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<PackedSourcePCK::Pack> &p_pack) :
+		pf(p_file),
+		pack(p_pack),
+		path(p_path) {
+	if (pack->data) {
+		data = pack->data + pf.offset;
+	}
+}
+
+//////////////////////////////////////////////////////////////////
+
+String DirAccessPack::_resolve(const String &p_path) const {
+	String nd = p_path.replace_char('\\', '/');
+	bool absolute = false;
+	if (nd.begins_with("res://")) {
+		nd = nd.trim_prefix("res://");
+		absolute = true;
+	} else if (nd.begins_with("/")) {
+		nd = nd.trim_prefix("/");
+		absolute = true;
+	}
+
+	Vector<String> parts = absolute ? Vector<String>() : current.split("/", false);
+	for (const String &p : nd.split("/", false)) {
+		if (p == ".") {
+			continue;
+		} else if (p == "..") {
+			if (!parts.is_empty()) {
+				parts.resize(parts.size() - 1);
+			}
+		} else {
+			parts.push_back(p);
+		}
+	}
+
+	return String("/").join(parts);
+}
+
+Error DirAccessPack::list_dir_begin() {
+	list_dir_end();
+
+	if (!PackedData::get_singleton()->get_directory_contents(current, list_dirs, list_files)) {
+		return ERR_CANT_OPEN;
+	}
+	return OK;
+}
+
+String DirAccessPack::get_next() {
+	if (list_index < list_dirs.size()) {
+		cdir = true;
+		return list_dirs[list_index++];
+	}
+
+	uint32_t file_index = list_index - list_dirs.size();
+	if (file_index < list_files.size()) {
+		cdir = false;
+		list_index++;
+		return list_files[file_index];
+	}
+
+	return String();
+}
+
+bool DirAccessPack::current_is_dir() const {
+	return cdir;
+}
+
+bool DirAccessPack::current_is_hidden() const {
+	return false;
+}
+
+void DirAccessPack::list_dir_end() {
+	list_dirs.clear();
+	list_files.clear();
+	list_index = 0;
+	cdir = false;
+}
+
+int DirAccessPack::get_drive_count() {
+	return 0;
+}
+
+String DirAccessPack::get_drive(int p_drive) {
+	return "";
+}
+
+Error DirAccessPack::change_dir(String p_dir) {
+	String dir = _resolve(p_dir);
+	if (!PackedData::get_singleton()->has_directory(dir)) {
+		return ERR_INVALID_PARAMETER;
+	}
+
+	current = dir;
+	return OK;
+}
+
+String DirAccessPack::get_current_dir(bool p_include_drive) const {
+	return "res://" + current;
+}
+
+bool DirAccessPack::file_exists(String p_file) {
+	return PackedData::get_singleton()->has_path("res://" + _resolve(p_file));
+}
+
+bool DirAccessPack::dir_exists(String p_dir) {
+	return PackedData::get_singleton()->has_directory(_resolve(p_dir));
+}
+
+Error DirAccessPack::make_dir(String p_dir) {
+	return ERR_UNAVAILABLE;
+}
+
+Error DirAccessPack::rename(String p_from, String p_to) {
+	return ERR_UNAVAILABLE;
+}
+
+Error DirAccessPack::remove(String p_name) {
+	return ERR_UNAVAILABLE;
+}
+
+uint64_t DirAccessPack::get_space_left() {
+	return 0;
+}
+
+String DirAccessPack::get_filesystem_type() const {
+	return "PCK";
+}
@@ -0,0 +1,252 @@
+/**************************************************************************/
+/*  file_access_pack.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/rw_lock.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+// Godot's own resource pack format. The directory and the per-file flags are
+// read by PackedSourcePCK; layout matches packs written by the upstream exporter.
+// Version 3 adds a directory offset after the file base.
+#define PACK_HEADER_MAGIC 0x43504447
+#define PACK_FORMAT_VERSION_V2 2
+#define PACK_FORMAT_VERSION_V3 3
+#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
+
+enum PackFlags {
+	PACK_DIR_ENCRYPTED = 1 << 0,
+	PACK_REL_FILEBASE = 1 << 1,
+	PACK_SPARSE_BUNDLE = 1 << 2,
+};
+
+enum PackFileFlags {
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_REMOVAL = 1 << 1,
+};
+
+class PackSource;
+
+// Virtual file layer shared by resource packs and mounted archives.
+// Sources register the files they provide under absolute virtual paths
+// (e.g. `res://icon.png` or `user://mods/my_mod/level.scn`), and
+// `FileAccess::open()` consults this index before touching the OS.
+//
+// Packs stack as overlays: a pack added with `replace_files` hides the
+// entries it overrides, and removing it brings those entries back.
+
+class PackedData {
+	friend class PackSource;
+
+public:
+	struct PackedFile {
+		String pack;
+		uint64_t offset = 0; // Offset of the file data inside the pack.
+		uint64_t size = 0;
+		PackSource *src = nullptr;
+		bool encrypted = false;
+		bool bundle = false; // Stored as a loose file next to the pack (sparse bundles).
+	};
+
+private:
+	struct PackedDir {
+		PackedDir *parent = nullptr;
+		String name;
+		HashMap<String, PackedDir *> subdirs;
+		HashSet<String> files;
+	};
+
+	HashMap<String, PackedFile> files;
+	HashMap<String, LocalVector<PackedFile>> shadowed; // Entries hidden by later packs, oldest first.
+	LocalVector<PackSource *> sources;
+	PackedDir *root = nullptr; // Directory tree of the `res://` entries, used by DirAccessPack.
+	mutable RWLock files_lock;
+
+	bool disabled = false;
+
+	static inline PackedData *singleton = nullptr;
+
+	_FORCE_INLINE_ static String _normalize_path(const String &p_path) { return p_path.simplify_path(); }
+
+	void _add_to_tree(const String &p_path);
+	void _remove_from_tree(const String &p_path);
+	const PackedDir *_find_dir(const String &p_dir) const;
+	void _free_packed_dirs(PackedDir *p_dir);
+
+public:
+	void add_pack_source(PackSource *p_source);
+	void add_path(const String &p_pack_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false);
+	void remove_path(const String &p_path);
+	void remove_pack(const String &p_pack_path);
+	void reserve(uint32_t p_file_count);
+
+	void set_disabled(bool p_disabled) { disabled = p_disabled; }
+	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
+
+	static PackedData *get_singleton() { return singleton; }
+	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
+
+	Ref<FileAccess> try_open_path(const String &p_path);
+	bool has_path(const String &p_path);
+
+	// Directories are given relative to `res://`, e.g. "" for the root or "levels/forest".
+	bool has_directory(const String &p_dir) const;
+	bool get_directory_contents(const String &p_dir, LocalVector<String> &r_dirs, LocalVector<String> &r_files) const;
+
+	PackedData();
+	~PackedData();
+};
+
+class PackSource {
+public:
+	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) = 0;
+	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) = 0;
+	virtual ~PackSource() {}
+};
+
+class PackedSourcePCK : public PackSource {
+public:
+	// One open handle per pack, shared by every file read from it.
+	class Pack : public RefCounted {
+		GDSOFTCLASS(Pack, RefCounted);
+
+	public:
+		Ref<FileAccess> file;
+		const uint8_t *data = nullptr; // Whole-pack mapping, when the platform provides one.
+		uint64_t length = 0;
+		BinaryMutex mutex; // Serializes seek + read on `file` when the pack isn't mapped.
+	};
+
+private:
+	HashMap<String, Ref<Pack>> packs;
+	BinaryMutex packs_mutex;
+
+public:
+	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
+	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+};
+
+class FileAccessPack : public FileAccess {
+	GDSOFTCLASS(FileAccessPack, FileAccess);
+	PackedData::PackedFile pf;
+	Ref<PackedSourcePCK::Pack> pack;
+	const uint8_t *data = nullptr; // Start of this file inside the pack mapping, if mapped.
+	String path;
+
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
+	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
+	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
+	virtual int64_t _get_size(const String &p_file) override { return -1; }
+	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
+	virtual Error _set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) override { return FAILED; }
+
+	virtual bool _get_hidden_attribute(const String &p_file) override { return false; }
+	virtual Error _set_hidden_attribute(const String &p_file, bool p_hidden) override { return ERR_UNAVAILABLE; }
+	virtual bool _get_read_only_attribute(const String &p_file) override { return false; }
+	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override { return ERR_UNAVAILABLE; }
+
+public:
+	virtual bool is_open() const override;
+
+	virtual String get_path() const override { return path; }
+	virtual String get_path_absolute() const override { return path; }
+
+	virtual void seek(uint64_t p_position) override;
+	virtual void seek_end(int64_t p_position = 0) override;
+	virtual uint64_t get_position() const override;
+	virtual uint64_t get_length() const override;
+
+	virtual bool eof_reached() const override;
+
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer() override { return data; }
+
+	virtual Error get_error() const override;
+
+	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
+	virtual void flush() override;
+	virtual bool store_buffer(const uint8_t *p_src, uint64_t p_length) override;
+
+	virtual bool file_exists(const String &p_name) override;
+
+	virtual void close() override;
+
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<PackedSourcePCK::Pack> &p_pack);
+};
+
+class DirAccessPack : public DirAccess {
+	GDSOFTCLASS(DirAccessPack, DirAccess);
+
+	String current; // Relative to `res://`.
+
+	LocalVector<String> list_dirs;
+	LocalVector<String> list_files;
+	uint32_t list_index = 0;
+	bool cdir = false;
+
+	String _resolve(const String &p_path) const;
+
+public:
+	virtual Error list_dir_begin() override;
+	virtual String get_next() override;
+	virtual bool current_is_dir() const override;
+	virtual bool current_is_hidden() const override;
+	virtual void list_dir_end() override;
+
+	virtual int get_drive_count() override;
+	virtual String get_drive(int p_drive) override;
+
+	virtual Error change_dir(String p_dir) override;
+	virtual String get_current_dir(bool p_include_drive = true) const override;
+
+	virtual bool file_exists(String p_file) override;
+	virtual bool dir_exists(String p_dir) override;
+
+	virtual Error make_dir(String p_dir) override;
+
+	virtual Error rename(String p_from, String p_to) override;
+	virtual Error remove(String p_name) override;
+
+	uint64_t get_space_left() override;
+
+	virtual bool is_link(String p_file) override { return false; }
+	virtual String read_link(String p_file) override { return p_file; }
+	virtual Error create_link(String p_source, String p_target) override { return FAILED; }
+
+	virtual String get_filesystem_type() const override;
+};
@@ -0,0 +1,218 @@
+/**************************************************************************/
+/*  file_access_quota.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_quota.h"
+
+Error FileAccessQuota::open_and_charge(const Ref<FileAccess> &p_base, const Ref<ModSandbox> &p_sandbox, uint64_t p_truncated_length) {
+	ERR_FAIL_COND_V(p_base.is_null() || p_sandbox.is_null(), ERR_INVALID_PARAMETER);
+
+	file = p_base;
+	sandbox = p_sandbox;
+	sandbox->release_quota(p_truncated_length);
+	charged_end = file->get_length(); // Only growth past the current size is charged.
+	return OK;
+}
+
+Error FileAccessQuota::open_internal(const String &p_path, int p_mode_flags) {
+	return OK;
+}
+
+bool FileAccessQuota::is_open() const {
+	return file.is_valid() && file->is_open();
+}
+
+String FileAccessQuota::get_path() const {
+	if (file.is_valid()) {
+		return file->get_path();
+	}
+	return "";
+}
+
+String FileAccessQuota::get_path_absolute() const {
+	if (file.is_valid()) {
+		return file->get_path_absolute();
+	}
+	return "";
+}
+
+void FileAccessQuota::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(file.is_null(), "File must be opened before use.");
+	file->seek(p_position);
+}
+
+void FileAccessQuota::seek_end(int64_t p_position) {
+	ERR_FAIL_COND_MSG(file.is_null(), "File must be opened before use.");
+	file->seek_end(p_position);
+}
+
+uint64_t FileAccessQuota::get_position() const {
+	ERR_FAIL_COND_V_MSG(file.is_null(), 0, "File must be opened before use.");
+	return file->get_position();
+}
+
+uint64_t FileAccessQuota::get_length() const {
+	ERR_FAIL_COND_V_MSG(file.is_null(), 0, "File must be opened before use.");
+	return file->get_length();
+}
+
+bool FileAccessQuota::eof_reached() const {
+	ERR_FAIL_COND_V_MSG(file.is_null(), true, "File must be opened before use.");
+	return file->eof_reached();
+}
+
+uint64_t FileAccessQuota::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(file.is_null(), -1, "File must be opened before use.");
+	return file->get_buffer(p_dst, p_length);
+}
+
+Error FileAccessQuota::get_error() const {
+	if (file.is_null()) {
+		return ERR_UNCONFIGURED;
+	}
+	return file->get_error();
+}
+
+Error FileAccessQuota::resize(int64_t p_length) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_UNCONFIGURED, "File must be opened before use.");
+
+	if ((uint64_t)p_length > charged_end) {
+		uint64_t growth = p_length - charged_end;
+		ERR_FAIL_COND_V_MSG(!sandbox->reserve_quota(growth), ERR_OUT_OF_MEMORY, vformat("Mod security: Storage quota of mod '%s' exceeded.", sandbox->get_mod()));
+		Error err = file->resize(p_length);
+		if (err == OK) {
+			charged_end = p_length;
+		} else {
+			sandbox->release_quota(growth);
+		}
+		return err;
+	} else if ((uint64_t)p_length < charged_end) {
+		Error err = file->resize(p_length);
+		if (err == OK) {
+			sandbox->release_quota(charged_end - p_length);
+			charged_end = p_length;
+		}
+		return err;
+	}
+	return file->resize(p_length);
+}
+
+void FileAccessQuota::flush() {
+	ERR_FAIL_COND_MSG(file.is_null(), "File must be opened before use.");
+	file->flush();
+}
+
+bool FileAccessQuota::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), false, "File must be opened before use.");
+
+	uint64_t end = file->get_position() + p_length;
+	if (end > charged_end) {
+		ERR_FAIL_COND_V_MSG(!sandbox->reserve_quota(end - charged_end), false, vformat("Mod security: Storage quota of mod '%s' exceeded.", sandbox->get_mod()));
+		charged_end = end;
+	}
+	return file->store_buffer(p_src, p_length);
+}
+
+bool FileAccessQuota::file_exists(const String &p_name) {
+	if (file.is_valid()) {
+		return file->file_exists(p_name);
+	}
+	return false;
+}
+
+uint64_t FileAccessQuota::_get_modified_time(const String &p_file) {
+	if (file.is_valid()) {
+		return file->get_modified_time(p_file);
+	}
+	return 0;
+}
+
+uint64_t FileAccessQuota::_get_access_time(const String &p_file) {
+	if (file.is_valid()) {
+		return file->get_access_time(p_file);
+	}
+	return 0;
+}
+
+int64_t FileAccessQuota::_get_size(const String &p_file) {
+	if (file.is_valid()) {
+		return file->get_size(p_file);
+	}
+	return -1;
+}
+
+BitField<FileAccess::UnixPermissionFlags> FileAccessQuota::_get_unix_permissions(const String &p_file) {
+	if (file.is_valid()) {
+		return file->_get_unix_permissions(p_file);
+	}
+	return 0;
+}
+
+Error FileAccessQuota::_set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) {
+	if (file.is_valid()) {
+		return file->_set_unix_permissions(p_file, p_permissions);
+	}
+	return FAILED;
+}
+
+bool FileAccessQuota::_get_hidden_attribute(const String &p_file) {
+	if (file.is_valid()) {
+		return file->_get_hidden_attribute(p_file);
+	}
+	return false;
+}
+
+Error FileAccessQuota::_set_hidden_attribute(const String &p_file, bool p_hidden) {
+	if (file.is_valid()) {
+		return file->_set_hidden_attribute(p_file, p_hidden);
+	}
+	return ERR_UNAVAILABLE;
+}
+
+bool FileAccessQuota::_get_read_only_attribute(const String &p_file) {
+	if (file.is_valid()) {
+		return file->_get_read_only_attribute(p_file);
+	}
+	return false;
+}
+
+Error FileAccessQuota::_set_read_only_attribute(const String &p_file, bool p_ro) {
+	if (file.is_valid()) {
+		return file->_set_read_only_attribute(p_file, p_ro);
+	}
+	return ERR_UNAVAILABLE;
+}
+
+void FileAccessQuota::close() {
+	if (file.is_valid()) {
+		file->close();
+	}
+	file.unref();
+	sandbox.unref();
+}
@@ -191,6 +191,8 @@ bool ZipArchive::try_open_pack(const String &p_path, bool p_replace_files, uint6
 		String fname = String("res://") + String::utf8(filename_inzip);
 		files[fname] = f;
 
+		PackedData::get_singleton()->add_path(p_path, fname, 0, file_info.uncompressed_size, this, p_replace_files);
+
 		if ((i + 1) < gi.number_entry) {
 			unzGoToNextFile(zfile);
 		}
@@ -205,7 +207,7 @@ bool ZipArchive::file_exists(const String &p_name) const {
 	return files.has(p_name);
 }
 
-Ref<FileAccess> ZipArchive::get_file(const String &p_path) {
+Ref<FileAccess> ZipArchive::get_file(const String &p_path, PackedData::PackedFile *p_file) {
 	return memnew(FileAccessZip(p_path));
 }
 
@@ -223,6 +225,10 @@ ZipArchive::ZipArchive() {
 
 ZipArchive::~ZipArchive() {
 	packages.clear();
+
+	if (instance == this) {
+		instance = nullptr;
+	}
 }
 
 Error FileAccessZip::open_internal(const String &p_path, int p_mode_flags) {
@@ -32,9 +32,11 @@
 
 #ifdef MINIZIP_ENABLED
 
+#include "core/io/file_access_pack.h"
+
 #include "thirdparty/minizip/unzip.h"
 
-class ZipArchive {
+class ZipArchive : public PackSource {
 public:
 	struct File {
 		int package = -1;
@@ -59,8 +61,8 @@ public:
 
 	bool file_exists(const String &p_name) const;
 
-	bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
-	Ref<FileAccess> get_file(const String &p_path);
+	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
+	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
 
 	static ZipArchive *get_singleton();
 
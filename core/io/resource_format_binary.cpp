@@ -33,8 +33,10 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 #include "scene/property_utils.h"
 #include "scene/resources/packed_scene.h"
@@ -109,11 +111,68 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
-static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
+Error ResourceLoaderBinary::_read_buffer(uint8_t *p_dst, uint64_t p_length) {
+	if (mapped) {
+		// Copy straight from the mapping, instead of going through the file's read path.
+		uint64_t position = f->get_position();
+		ERR_FAIL_COND_V(position > mapped_length || p_length > mapped_length - position, ERR_FILE_CORRUPT);
+		memcpy(p_dst, mapped + position, p_length);
+		f->seek(position + p_length);
+		return OK;
+	}
+
+	// The destination isn't initialized, so a short read must not go unnoticed.
+	ERR_FAIL_COND_V(f->get_buffer(p_dst, p_length) != p_length, ERR_FILE_CORRUPT);
+	return OK;
+}
+
+bool ResourceLoaderBinary::_skip_packed_array(uint32_t p_type) {
+	const uint64_t real_size = f->real_is_double ? sizeof(double) : sizeof(float);
+	uint64_t element_size = 0;
+
+	switch (p_type) {
+		case VARIANT_PACKED_BYTE_ARRAY: {
+			element_size = 1;
+		} break;
+		case VARIANT_PACKED_INT32_ARRAY:
+		case VARIANT_PACKED_FLOAT32_ARRAY: {
+			element_size = 4;
+		} break;
+		case VARIANT_PACKED_INT64_ARRAY:
+		case VARIANT_PACKED_FLOAT64_ARRAY: {
+			element_size = 8;
+		} break;
+		case VARIANT_PACKED_VECTOR2_ARRAY: {
+			element_size = real_size * 2;
+		} break;
+		case VARIANT_PACKED_VECTOR3_ARRAY: {
+			element_size = real_size * 3;
+		} break;
+		case VARIANT_PACKED_COLOR_ARRAY: {
+			element_size = sizeof(float) * 4;
+		} break;
+		case VARIANT_PACKED_VECTOR4_ARRAY: {
+			element_size = real_size * 4;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+	uint32_t len = f->get_32();
+	f->seek(f->get_position() + len * element_size);
+	if (p_type == VARIANT_PACKED_BYTE_ARRAY) {
+		_advance_padding(len);
+	}
+	return true;
+}
+
+Error ResourceLoaderBinary::_read_reals(real_t *dst, size_t count) {
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
 			// Ideal case with double-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(double));
+			Error err = _read_buffer((uint8_t *)dst, count * sizeof(double));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *dst = (uint64_t *)dst;
@@ -133,7 +192,8 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	} else {
 		if constexpr (sizeof(real_t) == 4) {
 			// Ideal case with float-precision
-			f->get_buffer((uint8_t *)dst, count * sizeof(float));
+			Error err = _read_buffer((uint8_t *)dst, count * sizeof(float));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *dst = (uint32_t *)dst;
@@ -153,18 +213,30 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	return OK;
 }
 
+String ResourceLoaderBinary::_read_utf8(uint32_t p_length) {
+	if (mapped) {
+		uint64_t position = f->get_position();
+		if (position <= mapped_length && p_length <= mapped_length - position) {
+			f->seek(position + p_length);
+			return String::utf8((const char *)mapped + position, p_length);
+		}
+	}
+
+	if ((int)p_length > str_buf.size()) {
+		str_buf.resize(p_length);
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], p_length);
+	return String::utf8(&str_buf[0], p_length);
+}
+
 StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
-		return String::utf8(&str_buf[0], len);
+		return _read_utf8(len);
 	}
 
 	return string_map[id];
@@ -174,6 +246,11 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 	uint32_t prop_type = f->get_32();
 	print_bl("find property of type: " + itos(prop_type));
 
+	if (scan_dependencies && _skip_packed_array(prop_type)) {
+		r_v = Variant();
+		return OK;
+	}
+
 	switch (prop_type) {
 		case VARIANT_NIL: {
 			r_v = Variant();
@@ -400,6 +477,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					uint32_t index = f->get_32();
 					String path;
 
+					if (scan_dependencies) {
+						scan_dependencies->push_back(index);
+						r_v = Variant();
+						break;
+					}
+
 					if (using_named_scene_ids) { // New format.
 						ERR_FAIL_INDEX_V((int)index, internal_resources.size(), ERR_PARSE_ERROR);
 						path = internal_resources[index].path;
@@ -408,11 +491,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					const HashMap<String, Ref<Resource>> &index_cache = shared_index_cache ? *shared_index_cache : internal_index_cache;
+					HashMap<String, Ref<Resource>>::ConstIterator cached = index_cache.find(path);
+					if (!cached) {
 						WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", path));
 						r_v = Variant();
 					} else {
-						r_v = internal_index_cache[path];
+						r_v = cached->value;
 					}
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
@@ -421,6 +506,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					String exttype = get_unicode_string();
 					String path = get_unicode_string();
 
+					if (scan_dependencies) {
+						break;
+					}
+
 					if (!path.contains("://") && path.is_relative_path()) {
 						// path is relative to file being loaded, so convert to a resource path
 						path = ProjectSettings::get_singleton()->localize_path(res_path.get_base_dir().path_join(path));
@@ -442,9 +531,19 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					//new file format, just refers to an index in the external list
 					int erindex = f->get_32();
 
+					if (scan_dependencies) {
+						break;
+					}
+
 					if (erindex < 0 || erindex >= external_resources.size()) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
+					} else if (external_resources_resolved) {
+						// Completed up front by _resolve_external_resources(), which already reported failures.
+						const Ref<Resource> &res = resolved_external_resources[erindex];
+						if (res.is_valid()) {
+							r_v = res;
+						}
 					} else {
 						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
 						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
@@ -510,9 +609,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<uint8_t> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			uint8_t *w = array.ptrw();
-			f->get_buffer(w, len);
+			const Error err = _read_buffer(w, len);
+			ERR_FAIL_COND_V(err != OK, err);
 			_advance_padding(len);
 
 			r_v = array;
@@ -522,9 +622,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<int32_t> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
+			const Error err = _read_buffer((uint8_t *)w, (uint64_t)len * sizeof(int32_t));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -541,9 +642,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<int64_t> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
+			const Error err = _read_buffer((uint8_t *)w, (uint64_t)len * sizeof(int64_t));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -560,9 +662,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<float> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
+			const Error err = _read_buffer((uint8_t *)w, (uint64_t)len * sizeof(float));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -579,9 +682,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<double> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
+			const Error err = _read_buffer((uint8_t *)w, (uint64_t)len * sizeof(double));
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint64_t *ptr = (uint64_t *)w.ptr();
@@ -610,10 +714,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<Vector2> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			Vector2 *w = array.ptrw();
 			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 2);
+			const Error err = _read_reals(reinterpret_cast<real_t *>(w), len * 2);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -623,10 +727,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<Vector3> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			Vector3 *w = array.ptrw();
 			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 3);
+			const Error err = _read_reals(reinterpret_cast<real_t *>(w), len * 3);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -636,11 +740,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<Color> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+			const Error err = _read_buffer((uint8_t *)w, (uint64_t)len * sizeof(float) * 4);
+			ERR_FAIL_COND_V(err != OK, err);
 #ifdef BIG_ENDIAN_ENABLED
 			{
 				uint32_t *ptr = (uint32_t *)w.ptr();
@@ -657,10 +762,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<Vector4> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			Vector4 *w = array.ptrw();
 			static_assert(sizeof(Vector4) == 4 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 4);
+			const Error err = _read_reals(reinterpret_cast<real_t *>(w), len * 4);
 			ERR_FAIL_COND_V(err != OK, err);
 
 			r_v = array;
@@ -678,212 +783,420 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
+Error ResourceLoaderBinary::_load_internal_resource(int p_index, const String &p_path, const String &p_id, Ref<Resource> &r_resource) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+	uint64_t offset = internal_resources[p_index].offset;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
+	f->seek(offset);
+
+	String t = get_unicode_string();
+
+	Ref<Resource> res;
+	Resource *r = nullptr;
+
+	MissingResource *missing_resource = nullptr;
+
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(p_path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(p_path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
+			}
 		}
 
-		if (!path.contains("://") && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
+				} else {
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
+				}
+			}
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
+			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
-		if (external_resources[i].load_token.is_null()) {
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
+	if (r) {
+		if (!p_path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(p_path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
 			} else {
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
+				r->set_path_cache(p_path);
 			}
 		}
+		r->set_scene_unique_id(p_id);
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	if (!main && !shared_index_cache) {
+		internal_index_cache[p_path] = res;
+	}
 
-		//maybe it is loaded already
-		String path;
-		String id;
+	int pc = f->get_32();
 
-		if (!main) {
-			path = internal_resources[i].path;
+	//set properties
+
+	Dictionary missing_resource_properties;
+
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+		if (name == StringName()) {
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+
+		Variant value;
+
+		error = parse_variant(value);
+		if (error) {
+			return error;
+		}
+
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
 
-				internal_resources.write[i].path = path; // Update path.
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
+		}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+		}
+
+		if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary set_dict = value;
+			bool is_get_valid = false;
+			Variant get_value = res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+				Dictionary get_dict = get_value;
+				if (!set_dict.is_same_typed(get_dict)) {
+					value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+							get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
+				}
 			}
 		}
 
-		uint64_t offset = internal_resources[i].offset;
+		if (set_valid) {
+			res->set(name, value);
+		}
+	}
 
-		f->seek(offset);
+	if (missing_resource) {
+		missing_resource->set_recording_properties(false);
+	}
 
-		String t = get_unicode_string();
+	if (!missing_resource_properties.is_empty()) {
+		res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
 
-		MissingResource *missing_resource = nullptr;
+	r_resource = res;
+	return OK;
+}
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+void ResourceLoaderBinary::_update_internal_resource_path(int p_index, String &r_path, String &r_id) {
+	r_path = internal_resources[p_index].path;
+
+	if (r_path.begins_with("local://")) {
+		r_path = r_path.replace_first("local://", "");
+		r_id = r_path;
+		r_path = res_path + "::" + r_path;
+
+		internal_resources.write[p_index].path = r_path; // Update path.
+	}
+}
+
+Error ResourceLoaderBinary::_resolve_external_resources() {
+	resolved_external_resources.resize(external_resources.size());
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[i].load_token;
+		if (load_token.is_null()) {
+			continue; // Already reported when starting the load.
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
+
+		Error err;
+		Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
+		if (res.is_null()) {
+			if (!ResourceLoader::is_cleaning_tasks()) {
+				if (!ResourceLoader::get_abort_on_missing_resources()) {
+					ResourceLoader::notify_dependency_error(local_path, external_resources[i].path, external_resources[i].type);
+				} else {
+					error = ERR_FILE_MISSING_DEPENDENCIES;
+					ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", external_resources[i].path));
 				}
 			}
+		} else {
+			resolved_external_resources.write[i] = res;
+		}
+	}
 
-			if (res.is_null()) {
-				//did not replace
+	external_resources_resolved = true;
+	return OK;
+}
 
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
-					}
-				}
+bool ResourceLoaderBinary::_scan_internal_dependencies(LocalVector<int> &r_levels) {
+	const int count = internal_resources.size() - 1; // The main resource is always loaded last.
+	r_levels.resize(count);
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
-				}
+	LocalVector<int> dependencies;
+	scan_dependencies = &dependencies;
+
+	bool valid = true;
+	int widest_level = 0;
+	LocalVector<int> level_sizes;
 
-				res = Ref<Resource>(r);
+	for (int i = 0; i < count && valid; i++) {
+		f->seek(internal_resources[i].offset);
+		(void)get_unicode_string(); // Type.
+
+		dependencies.clear();
+		int pc = f->get_32();
+		for (int j = 0; j < pc; j++) {
+			(void)_get_string(); // Name.
+			Variant value;
+			if (parse_variant(value) != OK || f->eof_reached()) {
+				valid = false;
+				break;
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
-				}
+		// Sub-resources are saved after everything they reference, anything else is decoded serially.
+		int level = 0;
+		for (int dependency : dependencies) {
+			if (dependency < 0 || dependency >= i) {
+				valid = false;
+				break;
 			}
-			r->set_scene_unique_id(id);
+			level = MAX(level, r_levels[dependency] + 1);
 		}
+		r_levels[i] = level;
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		if ((int)level_sizes.size() <= level) {
+			level_sizes.resize(level + 1);
+			level_sizes[level] = 0;
 		}
+		level_sizes[level]++;
+		widest_level = MAX(widest_level, (int)level_sizes[level]);
+	}
 
-		int pc = f->get_32();
+	scan_dependencies = nullptr;
+	error = OK;
 
-		//set properties
+	// A chain of sub-resources gains nothing from being spread across threads.
+	return valid && widest_level > 1;
+}
 
-		Dictionary missing_resource_properties;
+void ResourceLoaderBinary::_load_sub_resource_task(SubResourceTask *p_task) {
+	// Each task reads through its own view of the mapping, so nothing is shared but read-only state.
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_custom(mapped, mapped_length);
+	fa->set_big_endian(f->is_big_endian());
+	fa->real_is_double = f->real_is_double;
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	ResourceLoaderBinary loader;
+	loader.f = fa;
+	loader.mapped = mapped;
+	loader.mapped_length = mapped_length;
+	loader.local_path = local_path;
+	loader.res_path = res_path;
+	loader.ver_format = ver_format;
+	loader.string_map = string_map;
+	loader.using_named_scene_ids = using_named_scene_ids;
+	loader.external_resources = external_resources;
+	loader.internal_resources = internal_resources;
+	loader.remaps = remaps;
+	loader.cache_mode = cache_mode;
+	loader.cache_mode_for_external = cache_mode_for_external;
+	loader.shared_index_cache = &internal_index_cache;
+	loader.external_resources_resolved = true;
+	loader.resolved_external_resources = resolved_external_resources;
+
+	p_task->error = loader._load_internal_resource(p_task->index, internal_resources[p_task->index].path, p_task->id, p_task->resource);
+}
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+Error ResourceLoaderBinary::_load_internal_resources_threaded(const LocalVector<int> &p_levels) {
+	Error err = _resolve_external_resources();
+	if (err != OK) {
+		return err;
+	}
 
-			Variant value;
+	// Group the sub-resources by dependency depth: everything in a level only references earlier levels.
+	LocalVector<LocalVector<SubResourceTask>> levels;
+	for (uint32_t i = 0; i < p_levels.size(); i++) {
+		String path;
+		String id;
+		_update_internal_resource_path(i, path, id);
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				continue;
 			}
+		}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+		if (levels.size() <= (uint32_t)p_levels[i]) {
+			levels.resize(p_levels[i] + 1);
+		}
+		SubResourceTask task;
+		task.index = i;
+		task.id = id;
+		levels[p_levels[i]].push_back(task);
+	}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+	int loaded = 0;
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
+	for (LocalVector<SubResourceTask> &level : levels) {
+		if (level.size() == 1) {
+			_load_sub_resource_task(&level[0]);
+		} else {
+			// Waiting on individual tasks lets this thread help out, which matters when it is itself a pool thread.
+			task_ids.clear();
+			for (SubResourceTask &task : level) {
+				task_ids.push_back(WorkerThreadPool::get_singleton()->add_template_task(this, &ResourceLoaderBinary::_load_sub_resource_task, &task, true, SNAME("ResourceLoaderBinarySubResource")));
+			}
+			for (WorkerThreadPool::TaskID task_id : task_ids) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
 			}
+		}
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
-				}
+		// Publish the level before the next one starts referencing it.
+		for (SubResourceTask &task : level) {
+			if (task.error != OK) {
+				error = task.error;
+				return error;
 			}
+			internal_index_cache[internal_resources[task.index].path] = task.resource;
+			resource_cache.push_back(task.resource);
+		}
 
-			if (set_valid) {
-				res->set(name, value);
+		loaded += level.size();
+		if (progress) {
+			*progress = loaded / float(internal_resources.size());
+		}
+	}
+
+	error = OK;
+	return OK;
+}
+
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
+
+		if (remaps.has(path)) {
+			path = remaps[path];
+		}
+
+		if (!path.contains("://") && path.is_relative_path()) {
+			// path is relative to file being loaded, so convert to a resource path
+			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		}
+
+		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+		if (external_resources[i].load_token.is_null()) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
 			}
 		}
+	}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+	int first_serial = 0;
+	if (use_sub_threads && mapped && using_named_scene_ids && internal_resources.size() > SUB_RESOURCE_THREADING_THRESHOLD) {
+		LocalVector<int> levels;
+		if (_scan_internal_dependencies(levels)) {
+			Error err = _load_internal_resources_threaded(levels);
+			if (err != OK) {
+				return err;
+			}
+			// Only the main resource is left.
+			first_serial = internal_resources.size() - 1;
 		}
+	}
+
+	for (int i = first_serial; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+
+		//maybe it is loaded already
+		String path;
+		String id;
+
+		if (!main) {
+			_update_internal_resource_path(i, path, id);
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+				Ref<Resource> cached = ResourceCache::get_ref(path);
+				if (cached.is_valid()) {
+					//already loaded, don't do anything
+					error = OK;
+					internal_index_cache[path] = cached;
+					continue;
+				}
+			}
+		} else {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+				path = res_path;
+			}
 		}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		Ref<Resource> res;
+		Error err = _load_internal_resource(i, path, id, res);
+		if (err != OK) {
+			return err;
+		}
 
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
@@ -923,14 +1236,10 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
-	if (len == 0) {
+	if (len <= 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
-	return String::utf8(&str_buf[0], len);
+	return _read_utf8(len);
 }
 
 void ResourceLoaderBinary::get_classes_used(Ref<FileAccess> p_f, HashSet<StringName> *p_classes) {
@@ -1003,6 +1312,9 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 		ERR_FAIL_MSG(vformat("Unrecognized binary resource file: '%s'.", local_path));
 	}
 
+	mapped = f->get_mapped_buffer();
+	mapped_length = mapped ? f->get_length() : 0;
+
 	bool big_endian = f->get_32();
 	bool use_real64 = f->get_32();
 
@@ -1218,6 +1530,8 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), vformat("Cannot open file '%s'.", p_path));
+	// Resources are laid out in the order they're loaded in.
+	f->set_access_pattern(FileAccess::ACCESS_PATTERN_SEQUENTIAL);
 
 	ResourceLoaderBinary loader;
 	switch (p_cache_mode) {
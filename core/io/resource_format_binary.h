@@ -33,6 +33,7 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 
 class ResourceLoaderBinary {
@@ -44,6 +45,9 @@ class ResourceLoaderBinary {
 	uint32_t ver_format = 0;
 
 	Ref<FileAccess> f;
+	// View of the file when the backend can map it, strings are decoded from it without copying.
+	const uint8_t *mapped = nullptr;
+	uint64_t mapped_length = 0;
 
 	uint64_t importmd_ofs = 0;
 
@@ -55,6 +59,7 @@ class ResourceLoaderBinary {
 	Vector<StringName> string_map;
 
 	StringName _get_string();
+	String _read_utf8(uint32_t p_length);
 
 	struct ExtResource {
 		String path;
@@ -78,8 +83,36 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	// Set on the loaders decoding sub-resources in parallel: internal references resolve through
+	// the owner's cache, and external ones were already completed by the owner.
+	const HashMap<String, Ref<Resource>> *shared_index_cache = nullptr;
+	bool external_resources_resolved = false;
+	Vector<Ref<Resource>> resolved_external_resources;
+	// When set, parse_variant() only records the internal resources referenced, skipping bulk data.
+	LocalVector<int> *scan_dependencies = nullptr;
+
+	struct SubResourceTask {
+		int index = 0;
+		String id;
+		Ref<Resource> resource;
+		Error error = OK;
+	};
+
+	// Below this many sub-resources, spreading them over threads costs more than it saves.
+	static constexpr int SUB_RESOURCE_THREADING_THRESHOLD = 8;
+
+	bool _skip_packed_array(uint32_t p_type);
+	void _update_internal_resource_path(int p_index, String &r_path, String &r_id);
+	Error _load_internal_resource(int p_index, const String &p_path, const String &p_id, Ref<Resource> &r_resource);
+	Error _resolve_external_resources();
+	bool _scan_internal_dependencies(LocalVector<int> &r_levels);
+	Error _load_internal_resources_threaded(const LocalVector<int> &p_levels);
+	void _load_sub_resource_task(SubResourceTask *p_task);
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
+	Error _read_buffer(uint8_t *p_dst, uint64_t p_length);
+	Error _read_reals(real_t *dst, size_t count);
 
 	HashMap<String, String> remaps;
 	Error error = OK;
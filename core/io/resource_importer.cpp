@@ -40,6 +40,14 @@ bool ResourceFormatImporter::SortImporterByName::operator()(const Ref<ResourceIm
 	return p_a->get_importer_name() < p_b->get_importer_name();
 }
 
+String ResourceFormatImporter::_get_imported_path(const String &p_path, const String &p_imported_path) {
+	// Imported files shipped outside the project (e.g. mods) point to their data relative to the source file.
+	if (!p_imported_path.is_empty() && !p_imported_path.contains("://") && p_imported_path.is_relative_path()) {
+		return p_path.get_base_dir().path_join(p_imported_path).simplify_path();
+	}
+	return p_imported_path;
+}
+
 Error ResourceFormatImporter::_get_path_and_type(const String &p_path, PathAndType &r_path_and_type, bool p_load, bool *r_valid) const {
 	Error err;
 	Ref<FileAccess> f = FileAccess::open(p_path + ".import", FileAccess::READ, &err);
@@ -90,15 +98,15 @@ Error ResourceFormatImporter::_get_path_and_type(const String &p_path, PathAndTy
 			if (!path_found && assign.begins_with("path.") && r_path_and_type.path.is_empty()) {
 				String feature = assign.get_slicec('.', 1);
 				if (OS::get_singleton()->has_feature(feature)) {
-					r_path_and_type.path = value;
+					r_path_and_type.path = _get_imported_path(p_path, value);
 					path_found = true; // First match must have priority.
 				} else if (p_load && Image::can_decompress(feature) && !decomp_path_found) { // When loading, check for decompressable formats and use first one found if nothing else is supported.
-					decomp_path = value;
+					decomp_path = _get_imported_path(p_path, value);
 					decomp_path_found = true; // First match must have priority.
 				}
 
 			} else if (!path_found && assign == "path") {
-				r_path_and_type.path = value;
+				r_path_and_type.path = _get_imported_path(p_path, value);
 				path_found = true; // First match must have priority.
 			} else if (assign == "type") {
 				r_path_and_type.type = ClassDB::get_compatibility_remapped_class(value);
@@ -357,9 +365,9 @@ void ResourceFormatImporter::get_internal_resource_path_list(const String &p_pat
 
 		if (!assign.is_empty()) {
 			if (assign.begins_with("path.")) {
-				r_paths->push_back(value);
+				r_paths->push_back(_get_imported_path(p_path, value));
 			} else if (assign == "path") {
-				r_paths->push_back(value);
+				r_paths->push_back(_get_imported_path(p_path, value));
 			}
 		} else if (next_tag.name != "remap") {
 			break;
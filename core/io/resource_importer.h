@@ -50,6 +50,7 @@ class ResourceFormatImporter : public ResourceFormatLoader {
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 	};
 
+	static String _get_imported_path(const String &p_path, const String &p_imported_path);
 	Error _get_path_and_type(const String &p_path, PathAndType &r_path_and_type, bool p_load, bool *r_valid = nullptr) const;
 
 	static inline ResourceFormatImporter *singleton = nullptr;
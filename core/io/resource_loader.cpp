@@ -30,10 +30,12 @@
 
 #include "resource_loader.h"
 
+#include "core/config/mod_security.h"
 #include "core/config/project_settings.h"
 #include "core/core_bind.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_async.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -371,6 +373,10 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 		}
 	}
 
+	// The load may run on a pool thread or be picked up by another waiter, so
+	// apply the requester's sandbox explicitly.
+	ModSecurity::Scope sandbox_scope(load_task.sandbox);
+
 	ThreadLoadTask *curr_load_task_backup = curr_load_task;
 	curr_load_task = &load_task;
 
@@ -613,6 +619,7 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			load_task.sandbox = ModSecurity::get_current_sandbox();
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
@@ -652,6 +659,10 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 				load_task_ptr->thread_id = Thread::get_caller_id();
 			}
 		} else {
+			// Until a worker picks the task up, the file can already be on its way from disk.
+			if (FileAccessAsync::get_singleton()) {
+				FileAccessAsync::get_singleton()->prefetch(_path_remap(local_path));
+			}
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_task, load_task_ptr);
 		}
 	} // MutexLock(thread_load_mutex).
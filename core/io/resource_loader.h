@@ -192,6 +192,7 @@ private:
 		Ref<Resource> resource;
 		bool use_sub_threads = false;
 		HashSet<String> sub_tasks;
+		Ref<ModSandbox> sandbox; // Mod sandbox of the thread that requested the load, if any.
 
 		struct ResourceChangedConnection {
 			Resource *source = nullptr;
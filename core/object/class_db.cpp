@@ -1069,14 +1069,61 @@ bool ClassDB::get_method_info(const StringName &p_class, const StringName &p_met
 	return false;
 }
 
+// Lock-free cache of the lookups done by get_method(). Entries are tagged with the epoch
+// of the class database, which changes on every write to it. Only found methods are cached,
+// so the names compared by pointer are kept alive by the database itself.
+struct MethodCacheEntry {
+	std::atomic<uint32_t> version; // Odd while the entry is being written.
+	std::atomic<uint32_t> epoch;
+	std::atomic<const void *> class_name;
+	std::atomic<const void *> method_name;
+	std::atomic<MethodBind *> method;
+};
+
+static constexpr uint32_t METHOD_CACHE_SIZE = 4096;
+static MethodCacheEntry method_cache[METHOD_CACHE_SIZE];
+static std::atomic<uint32_t> method_cache_epoch = 1; // Entries start at zero, so they are invalid.
+
+void ClassDB::_invalidate_method_cache() {
+	method_cache_epoch.fetch_add(1, std::memory_order_release);
+}
+
 MethodBind *ClassDB::get_method(const StringName &p_class, const StringName &p_name) {
+	MethodCacheEntry &entry = method_cache[hash_murmur3_one_32(p_name.hash(), p_class.hash()) & (METHOD_CACHE_SIZE - 1)];
+
+	uint32_t version = entry.version.load(std::memory_order_acquire);
+	if (!(version & 1)) {
+		uint32_t epoch = entry.epoch.load(std::memory_order_relaxed);
+		const void *class_name = entry.class_name.load(std::memory_order_relaxed);
+		const void *method_name = entry.method_name.load(std::memory_order_relaxed);
+		MethodBind *method = entry.method.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (entry.version.load(std::memory_order_relaxed) == version && epoch == method_cache_epoch.load(std::memory_order_acquire) &&
+				class_name == p_class.data_unique_pointer() && method_name == p_name.data_unique_pointer()) {
+			return method;
+		}
+	}
+
 	Locker::Lock lock(Locker::STATE_READ);
 
+	// Writers bump the epoch before releasing the lock, so this matches what is found below.
+	uint32_t epoch = method_cache_epoch.load(std::memory_order_acquire);
+
 	ClassInfo *type = classes.getptr(p_class);
 
 	while (type) {
 		MethodBind **method = type->method_map.getptr(p_name);
 		if (method && *method) {
+			// Skip caching if another thread is writing the entry.
+			version = entry.version.load(std::memory_order_relaxed);
+			if (!(version & 1) && entry.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)) {
+				std::atomic_thread_fence(std::memory_order_release);
+				entry.epoch.store(epoch, std::memory_order_relaxed);
+				entry.class_name.store(p_class.data_unique_pointer(), std::memory_order_relaxed);
+				entry.method_name.store(p_name.data_unique_pointer(), std::memory_order_relaxed);
+				entry.method.store(*method, std::memory_order_relaxed);
+				entry.version.store(version + 2, std::memory_order_release);
+			}
 			return *method;
 		}
 		type = type->inherits_ptr;
@@ -1795,6 +1842,31 @@ StringName ClassDB::get_property_setter(const StringName &p_class, const StringN
 	return StringName();
 }
 
+// Returns the bound setter that ClassDB::set_property() would call on instances
+// of p_class, or nullptr if there is none. Extension classes return nullptr,
+// since their instances may intercept the assignment before ClassDB does.
+MethodBind *ClassDB::get_property_setter_method(const StringName &p_class, const StringName &p_property, int *r_index) {
+	ClassInfo *type = classes.getptr(p_class);
+	if (!type || type->gdextension) {
+		return nullptr;
+	}
+
+	ClassInfo *check = type;
+	while (check) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+		if (psg) {
+			if (r_index) {
+				*r_index = psg->index;
+			}
+			return psg->_setptr;
+		}
+
+		check = check->inherits_ptr;
+	}
+
+	return nullptr;
+}
+
 StringName ClassDB::get_property_getter(const StringName &p_class, const StringName &p_property) {
 	ClassInfo *type = classes.getptr(p_class);
 	ClassInfo *check = type;
@@ -1921,6 +1993,7 @@ void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_metho
 }
 
 MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility) {
+	Locker::Lock lock(Locker::STATE_WRITE);
 	MethodBind *bind = p_bind;
 	bind->set_name(p_name);
 	bind->set_default_arguments(p_default_args);
@@ -2362,6 +2435,7 @@ void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_
 		}
 	}
 	classes.erase(p_class);
+	_invalidate_method_cache();
 	default_values_cached.erase(p_class);
 	default_values.erase(p_class);
 #ifdef TOOLS_ENABLED
@@ -2419,6 +2493,7 @@ void ClassDB::cleanup() {
 	}
 
 	classes.clear();
+	_invalidate_method_cache();
 	resource_base_extensions.clear();
 	compat_classes.clear();
 	native_structs.clear();
@@ -2446,6 +2521,7 @@ ClassDB::Locker::Lock::Lock(Locker::State p_state) {
 			state = STATE_WRITE;
 			Locker::thread_state = STATE_WRITE;
 			Locker::lock.write_lock();
+			_invalidate_method_cache(); // Lookups by this thread must not see entries cached before writing.
 		} else if (Locker::thread_state == STATE_READ) {
 			CRASH_NOW_MSG("Lock can't be upgraded from read to write.");
 		}
@@ -2457,6 +2533,8 @@ ClassDB::Locker::Lock::~Lock() {
 		Locker::lock.read_unlock();
 		Locker::thread_state = STATE_UNLOCKED;
 	} else if (state == STATE_WRITE) {
+		// Anything may have changed, so lookups cached meanwhile can't be trusted.
+		_invalidate_method_cache();
 		Locker::lock.write_unlock();
 		Locker::thread_state = STATE_UNLOCKED;
 	}
@@ -39,32 +39,135 @@
 #ifdef DEV_ENABLED
 // Includes safety checks to ensure that a queue set as a thread singleton override
 // is only ever called from the thread it was set for.
-#define LOCK_MUTEX                                \
+#define CHECK_THREAD_OVERRIDE                     \
 	if (this != MessageQueue::thread_singleton) { \
 		DEV_ASSERT(!is_current_thread_override);  \
-		mutex.lock();                             \
 	} else {                                      \
 		DEV_ASSERT(is_current_thread_override);   \
 	}
 #else
+#define CHECK_THREAD_OVERRIDE
+#endif
+
 #define LOCK_MUTEX                                \
+	CHECK_THREAD_OVERRIDE                         \
 	if (this != MessageQueue::thread_singleton) { \
 		mutex.lock();                             \
 	}
-#endif
 
 #define UNLOCK_MUTEX                              \
 	if (this != MessageQueue::thread_singleton) { \
 		mutex.unlock();                           \
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+static SafeNumeric<uint32_t> thread_buffer_counter;
+static thread_local uint32_t thread_buffer_index = thread_buffer_counter.postincrement();
+
+// Sequence numbers wrap around, but only a window of them is ever queued at once.
+static _FORCE_INLINE_ bool _is_older(uint32_t p_sequence, uint32_t p_than) {
+	return int32_t(p_sequence - p_than) < 0;
+}
+
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+
+	p_message->~Message();
+}
+
+CallQueue::Buffer &CallQueue::_get_buffer() {
+	CHECK_THREAD_OVERRIDE;
+	return buffers[thread_buffer_index % BUFFER_COUNT];
+}
+
+// Must be called with the buffer locked. Returns nullptr if the queue is out of pages.
+uint8_t *CallQueue::_reserve_message(Buffer &p_buffer, uint32_t p_room_needed) {
+	if (p_buffer.pages_used == 0 || (p_buffer.page_bytes[p_buffer.pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (total_pages_used.load(std::memory_order_relaxed) >= max_pages) {
+			return nullptr;
+		}
+		total_pages_used.fetch_add(1, std::memory_order_relaxed);
+
+		if (p_buffer.pages_used == p_buffer.pages.size()) {
+			p_buffer.pages.push_back(allocator->alloc());
+			p_buffer.page_bytes.push_back(0);
+		}
+		p_buffer.page_bytes[p_buffer.pages_used] = 0;
+		p_buffer.pages_used++;
+	}
+
+	return &p_buffer.pages[p_buffer.pages_used - 1]->data[p_buffer.page_bytes[p_buffer.pages_used - 1]];
+}
+
+// Must be called with the buffer locked, so sequence numbers grow within each buffer.
+void CallQueue::_commit_message(Buffer &p_buffer, Message *p_message, uint32_t p_room_needed) {
+	p_message->sequence = sequence.fetch_add(1, std::memory_order_relaxed);
+	p_buffer.page_bytes[p_buffer.pages_used - 1] += p_room_needed;
+	p_buffer.message_count.fetch_add(1, std::memory_order_release);
+}
+
+// Must be called with the buffer locked.
+CallQueue::Message *CallQueue::_get_next_message(Buffer &p_buffer) {
+	while (p_buffer.read_page < p_buffer.pages_used) {
+		if (p_buffer.read_offset < p_buffer.page_bytes[p_buffer.read_page]) {
+			return (Message *)&p_buffer.pages[p_buffer.read_page]->data[p_buffer.read_offset];
+		}
+		if (p_buffer.read_page + 1 == p_buffer.pages_used) {
+			break;
+		}
+		p_buffer.read_page++;
+		p_buffer.read_offset = 0;
+	}
+	return nullptr;
+}
+
+// Must be called with the buffer locked, once all its messages were flushed.
+void CallQueue::_reset_buffer(Buffer &p_buffer) {
+	total_pages_used.fetch_sub(p_buffer.pages_used, std::memory_order_relaxed);
+	p_buffer.pages_used = 0;
+	p_buffer.read_page = 0;
+	p_buffer.read_offset = 0;
+}
+
+// Must be called with the buffer locked, while no message of it is being flushed.
+// Gives back the pages already flushed, so a buffer that is pushed into during every flush doesn't grow.
+void CallQueue::_recycle_read_pages(Buffer &p_buffer) {
+	const uint32_t consumed = p_buffer.read_page;
+	if (consumed == 0) {
+		return;
+	}
+
+	// Rotate the consumed pages past the ones in use, where they are reused by later pushes.
+	const uint32_t remaining = p_buffer.pages_used - consumed;
+	Page **pages = p_buffer.pages.ptr();
+	for (uint32_t i = 0, j = consumed - 1; i < j; i++, j--) {
+		SWAP(pages[i], pages[j]);
+	}
+	for (uint32_t i = consumed, j = p_buffer.pages_used - 1; i < j; i++, j--) {
+		SWAP(pages[i], pages[j]);
+	}
+	for (uint32_t i = 0, j = p_buffer.pages_used - 1; i < j; i++, j--) {
+		SWAP(pages[i], pages[j]);
+	}
+	for (uint32_t i = 0; i < remaining; i++) {
+		p_buffer.page_bytes[i] = p_buffer.page_bytes[i + consumed];
+	}
+
+	total_pages_used.fetch_sub(consumed, std::memory_order_relaxed);
+	p_buffer.pages_used = remaining;
+	p_buffer.read_page = 0;
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -88,24 +191,17 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
+	Buffer &buffer = _get_buffer();
+	buffer.lock.lock();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = _reserve_message(buffer, room_needed);
+	if (unlikely(buffer_end == nullptr)) {
+		buffer.lock.unlock();
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -126,37 +222,30 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_commit_message(buffer, msg, room_needed);
+	buffer.lock.unlock();
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
+	Buffer &buffer = _get_buffer();
+	buffer.lock.lock();
 
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	uint8_t *buffer_end = _reserve_message(buffer, room_needed);
+	if (unlikely(buffer_end == nullptr)) {
+		buffer.lock.unlock();
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -167,32 +256,27 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_commit_message(buffer, msg, room_needed);
+	buffer.lock.unlock();
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
+	Buffer &buffer = _get_buffer();
+	buffer.lock.lock();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = _reserve_message(buffer, room_needed);
+	if (unlikely(buffer_end == nullptr)) {
+		buffer.lock.unlock();
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -200,8 +284,8 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_commit_message(buffer, msg, room_needed);
+	buffer.lock.unlock();
 
 	return OK;
 }
@@ -226,8 +310,8 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
-		// Never allocated
+	if (total_pages_used.load(std::memory_order_acquire) == 0) {
+		// Nothing pushed since the last flush.
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
 	}
@@ -239,66 +323,102 @@ Error CallQueue::flush() {
 
 	flushing = true;
 
-	uint32_t i = 0;
-	uint32_t offset = 0;
-
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	while (true) {
+		// Pick the buffer holding the oldest message, and flush it in one batch up to the
+		// oldest message of the other buffers. Messages pushed meanwhile are newer than both,
+		// so everything is flushed in the order it was pushed.
+		Buffer *next = nullptr;
+		uint32_t next_sequence = 0;
+		uint32_t bound = 0;
+		bool bounded = false;
+
+		for (Buffer &buffer : buffers) {
+			if (buffer.message_count.load(std::memory_order_acquire) == 0) {
+				continue;
+			}
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+			buffer.lock.lock();
+			Message *message = _get_next_message(buffer);
+			uint32_t message_sequence = message ? message->sequence : 0;
+			buffer.lock.unlock();
 
-		Message *message = (Message *)&page->data[offset];
+			if (!message) {
+				continue;
+			}
+			if (!next || _is_older(message_sequence, next_sequence)) {
+				if (next) {
+					bound = next_sequence;
+					bounded = true;
+				}
+				next = &buffer;
+				next_sequence = message_sequence;
+			} else if (!bounded || _is_older(message_sequence, bound)) {
+				bound = message_sequence;
+				bounded = true;
+			}
+		}
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+		if (!next) {
+			break;
 		}
 
-		//pre-advance so this function is reentrant
-		offset += advance;
+		while (true) {
+			//lock on each iteration, so a call can re-add itself to the message queue
 
-		Object *target = message->callable.get_object();
+			next->lock.lock();
+			Message *message = _get_next_message(*next);
+			if (!message || (bounded && !_is_older(message->sequence, bound))) {
+				next->lock.unlock();
+				break;
+			}
 
-		UNLOCK_MUTEX;
+			//pre-advance so this function is reentrant
+			next->read_offset += _get_message_size(message);
+			next->lock.unlock();
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
+			Object *target = message->callable.get_object();
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+			UNLOCK_MUTEX;
+
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = (Variant *)(message + 1);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = (Variant *)(message + 1);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
 			}
-		}
 
-		message->~Message();
+			_destroy_message(message);
+			next->message_count.fetch_sub(1, std::memory_order_release);
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
+			LOCK_MUTEX;
 		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	// Buffers pushed into since they were last checked keep their messages for the next flush.
+	for (Buffer &buffer : buffers) {
+		buffer.lock.lock();
+		if (buffer.pages_used > 0) {
+			if (_get_next_message(buffer) == nullptr) {
+				_reset_buffer(buffer);
+			} else {
+				_recycle_read_pages(buffer);
+			}
+		}
+		buffer.lock.unlock();
+	}
 
 	flushing = false;
 	UNLOCK_MUTEX;
@@ -308,40 +428,23 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+	for (Buffer &buffer : buffers) {
+		buffer.lock.lock();
 
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
+		Message *message = _get_next_message(buffer);
+		while (message) {
+			buffer.read_offset += _get_message_size(message);
+			_destroy_message(message);
+			buffer.message_count.fetch_sub(1, std::memory_order_release);
+			message = _get_next_message(buffer);
+		}
 
-			message->~Message();
+		if (buffer.pages_used > 0) {
+			_reset_buffer(buffer);
 		}
-	}
 
-	pages_used = 1;
-	page_bytes[0] = 0;
+		buffer.lock.unlock();
+	}
 
 	UNLOCK_MUTEX;
 }
@@ -353,77 +456,68 @@ void CallQueue::statistics() {
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+	for (Buffer &buffer : buffers) {
+		buffer.lock.lock();
 
-			//lock on each iteration, so a call can re-add itself to the message queue
+		for (uint32_t i = buffer.read_page; i < buffer.pages_used; i++) {
+			uint32_t offset = i == buffer.read_page ? buffer.read_offset : 0;
+			while (offset < buffer.page_bytes[i]) {
+				Page *page = buffer.pages[i];
 
-			Message *message = (Message *)&page->data[offset];
+				Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+				Object *target = message->callable.get_object();
 
-			Object *target = message->callable.get_object();
+				bool null_target = true;
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
 
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
+							call_count[message->callable]++;
+							null_target = false;
 						}
-
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
+
+							notify_count[message->notification]++;
+							null_target = false;
 						}
-
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
+
+							set_count[t]++;
+							null_target = false;
 						}
+					} break;
+				}
+				if (null_target) {
+					// Object was deleted.
+					fprintf(stdout, "Object was deleted while awaiting a callback.\n");
 
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				// Object was deleted.
-				fprintf(stdout, "Object was deleted while awaiting a callback.\n");
-
-				null_count++;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+					null_count++;
 				}
-			}
 
-			message->~Message();
+				offset += _get_message_size(message);
+			}
 		}
+
+		buffer.lock.unlock();
 	}
 
-	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	uint32_t total_pages = total_pages_used.load(std::memory_order_relaxed);
+	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", total_pages, total_pages * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -446,18 +540,23 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
+	for (const Buffer &buffer : buffers) {
+		if (buffer.message_count.load(std::memory_order_acquire) > 0) {
+			return true;
+		}
 	}
 
-	return true;
+	return false;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	int usage = 0;
+	for (const Buffer &buffer : buffers) {
+		buffer.lock.lock();
+		usage += buffer.pages.size() * PAGE_SIZE_BYTES;
+		buffer.lock.unlock();
+	}
+	return usage;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -475,8 +574,10 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 CallQueue::~CallQueue() {
 	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	for (Buffer &buffer : buffers) {
+		for (uint32_t i = 0; i < buffer.pages.size(); i++) {
+			allocator->free(buffer.pages[i]);
+		}
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
@@ -31,9 +31,11 @@
 #pragma once
 
 #include "core/object/object_id.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -65,15 +67,35 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
-	Mutex mutex;
+	enum {
+		// Threads are spread over this many buffers, so they rarely push into the same one.
+		BUFFER_COUNT = 16,
+	};
+
+	// Pages of messages pushed by the threads mapped to this buffer.
+	// Pushing only locks the buffer, so threads don't contend with each other
+	// and only briefly with a flush.
+	struct Buffer {
+		SpinLock lock;
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		uint32_t pages_used = 0;
+		// Position of the next message to flush.
+		uint32_t read_page = 0;
+		uint32_t read_offset = 0;
+		std::atomic<uint32_t> message_count = 0;
+	};
+
+	Mutex mutex; // Serializes flushing, clearing and statistics, not pushing.
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	Buffer buffers[BUFFER_COUNT];
+	std::atomic<uint32_t> total_pages_used = 0;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
+	// Orders messages across buffers, so they are flushed in the order they were pushed.
+	std::atomic<uint32_t> sequence = 0;
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
@@ -87,17 +109,18 @@ private:
 			int16_t notification;
 			int16_t args;
 		};
+		uint32_t sequence;
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
-		}
-	}
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _destroy_message(Message *p_message);
 
-	void _add_page();
+	Buffer &_get_buffer();
+	uint8_t *_reserve_message(Buffer &p_buffer, uint32_t p_room_needed);
+	void _commit_message(Buffer &p_buffer, Message *p_message, uint32_t p_room_needed);
+	Message *_get_next_message(Buffer &p_buffer);
+	void _reset_buffer(Buffer &p_buffer);
+	void _recycle_read_pages(Buffer &p_buffer);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -1251,19 +1251,41 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+void Object::_call_method_bind(Object *p_target, MethodBind *p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	r_error.error = Callable::CallError::CALL_OK;
+
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(p_target);
+#endif
+
+	// When the arguments already have the exact types the method takes, skip the
+	// checks and conversions of a regular call. Objects, arrays and dictionaries are
+	// excluded, since their class or element types would still need to be checked.
+	bool validated = !p_method->is_vararg() && !p_method->has_return() && p_argcount == p_method->get_argument_count();
+	for (int i = 0; validated && i < p_argcount; i++) {
+		Variant::Type type = p_method->get_argument_type(i);
+		if (type == Variant::OBJECT || type == Variant::ARRAY || type == Variant::DICTIONARY) {
+			validated = false;
+		} else {
+			validated = type == Variant::NIL || type == p_args[i]->get_type();
+		}
+	}
+
+	if (validated) {
+		p_method->validated_call(p_target, p_args, nullptr);
+	} else {
+		p_method->call(p_target, p_args, p_argcount, r_error);
+	}
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	// Sharing the connection array ensures that disconnecting the signal or even
+	// deleting the object will not affect the signal calling, without copying it.
+	Vector<SignalData::Dispatch> dispatch;
 
 	{
 		OBJ_SIGNAL_LOCK
@@ -1279,32 +1301,21 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
-		}
-
-		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
+		dispatch = s->dispatch;
 
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		DEV_ASSERT(uint32_t(dispatch.size()) == s->slot_map.size() + s->dispatch_removed);
 
 		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		for (const SignalData::Dispatch &slot : dispatch) {
+			bool disconnect = slot.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+			if (disconnect && (slot.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
 				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
 				disconnect = false;
 			}
 #endif
 			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+				_disconnect(p_name, slot.callable);
 			}
 		}
 	}
@@ -1320,53 +1331,67 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
-
-		if (!callable.is_valid()) {
-			// Target might have been deleted during signal callback, this is expected and OK.
-			continue;
-		}
+	const SignalData::Dispatch *slots = dispatch.ptr();
+	for (int i = 0; i < dispatch.size(); ++i) {
+		const Callable &callable = slots[i].callable;
+		const uint32_t &flags = slots[i].flags;
 
 		const Variant **args = p_args;
 		int argc = p_argcount;
 
-		if (flags & CONNECT_DEFERRED) {
-			MessageQueue::get_singleton()->push_callablep(callable, args, argc, true);
+		Callable::CallError ce;
+
+		if (slots[i].method) {
+			Object *target = callable.get_object();
+			if (!target) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+
+			if (likely(!target->script_instance)) {
+				_emitting = true;
+				_call_method_bind(target, slots[i].method, args, argc, ce);
+				_emitting = false;
+			} else {
+				// The script may override the method, so go through Object::callp().
+				_emitting = true;
+				Variant ret;
+				callable.callp(args, argc, ret, ce);
+				_emitting = false;
+			}
 		} else {
-			Callable::CallError ce;
+			if (!callable.is_valid()) {
+				// Target might have been deleted during signal callback, this is expected and OK.
+				continue;
+			}
+
+			if (flags & CONNECT_DEFERRED) {
+				MessageQueue::get_singleton()->push_callablep(callable, args, argc, true);
+				continue;
+			}
+
 			_emitting = true;
 			Variant ret;
 			callable.callp(args, argc, ret, ce);
 			_emitting = false;
+		}
 
-			if (ce.error != Callable::CallError::CALL_OK) {
+		if (ce.error != Callable::CallError::CALL_OK) {
 #ifdef DEBUG_ENABLED
-				if (flags & CONNECT_PERSIST && Engine::get_singleton()->is_editor_hint() && (!script_instance || !script_instance->get_script()->is_tool())) {
-					continue;
-				}
+			if (flags & CONNECT_PERSIST && Engine::get_singleton()->is_editor_hint() && (!script_instance || !script_instance->get_script()->is_tool())) {
+				continue;
+			}
 #endif
-				Object *target = callable.get_object();
-				if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && target && !ClassDB::class_exists(target->get_class_name())) {
-					//most likely object is not initialized yet, do not throw error.
-				} else {
-					ERR_PRINT(vformat("Error calling from signal '%s' to callable: %s.", String(p_name), Variant::get_callable_error_text(callable, args, argc, ce)));
-					err = ERR_METHOD_NOT_FOUND;
-				}
+			Object *target = callable.get_object();
+			if (ce.error == Callable::CallError::CALL_ERROR_INVALID_METHOD && target && !ClassDB::class_exists(target->get_class_name())) {
+				//most likely object is not initialized yet, do not throw error.
+			} else {
+				ERR_PRINT(vformat("Error calling from signal '%s' to callable: %s.", String(p_name), Variant::get_callable_error_text(callable, args, argc, ce)));
+				err = ERR_METHOD_NOT_FOUND;
 			}
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
-
 	if (pending_unref) {
 		// We have to do the same Ref<T> would do. We can't just use Ref<T>
 		// because it would do the init ref logic, which is something this function
@@ -1605,9 +1630,19 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 		slot.reference_count = 1;
 	}
 
+	slot.dispatch_index = s->dispatch.size();
+
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
 
+	SignalData::Dispatch dispatch;
+	dispatch.callable = p_callable;
+	dispatch.flags = p_flags;
+	if (target_object && p_callable.is_standard() && !(p_flags & CONNECT_DEFERRED) && p_callable.get_method() != CoreStringName(free_)) {
+		dispatch.method = ClassDB::get_method(target_object->get_class_name(), p_callable.get_method());
+	}
+	s->dispatch.push_back(dispatch);
+
 	return OK;
 }
 
@@ -1686,8 +1721,17 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 		}
 	}
 
+	// Leave an empty entry instead of shifting the later connections, so that
+	// disconnecting all of them stays linear.
+	s->dispatch.write[slot->dispatch_index] = SignalData::Dispatch();
+	s->dispatch_removed++;
+
 	s->slot_map.erase(*p_callable.get_base_comparator());
 
+	if (s->dispatch_removed * 2 > uint32_t(s->dispatch.size())) {
+		_compact_signal_dispatch(s);
+	}
+
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
 		signal_map.erase(p_signal);
@@ -1696,6 +1740,26 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	return true;
 }
 
+void Object::_compact_signal_dispatch(SignalData *p_signal) {
+	SignalData::Dispatch *dispatch = p_signal->dispatch.ptrw();
+	uint32_t count = 0;
+	for (int i = 0; i < p_signal->dispatch.size(); i++) {
+		if (dispatch[i].callable.is_null()) {
+			continue;
+		}
+		if (count != uint32_t(i)) {
+			dispatch[count] = dispatch[i];
+		}
+		SignalData::Slot *slot = p_signal->slot_map.getptr(*dispatch[count].callable.get_base_comparator());
+		DEV_ASSERT(slot);
+		slot->dispatch_index = count;
+		count++;
+	}
+
+	p_signal->dispatch.resize(count);
+	p_signal->dispatch_removed = 0;
+}
+
 bool Object::_uses_signal_mutex() const {
 	return true;
 }
@@ -2430,8 +2494,9 @@ void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
 	spin_lock.lock();
 
 	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
+		const ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.validator.load(std::memory_order_relaxed)) {
+			p_func(object_slot.object.load(std::memory_order_relaxed), p_user_data);
 			count--;
 		}
 	}
@@ -2487,7 +2552,7 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 SpinLock ObjectDB::spin_lock;
 uint32_t ObjectDB::slot_count = 0;
 uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::slot_chunks[OBJECTDB_CHUNK_COUNT] = {};
 uint64_t ObjectDB::validator_counter = 0;
 
 int ObjectDB::get_object_count() {
@@ -2499,29 +2564,31 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 	if (unlikely(slot_count == slot_max)) {
 		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+		ObjectSlot *chunk = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_CHUNK_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_CHUNK_SIZE; i++) {
+			memnew_placement(&chunk[i], ObjectSlot);
+			chunk[i].validator.store(0, std::memory_order_relaxed);
+			chunk[i].object.store(nullptr, std::memory_order_relaxed);
+			chunk[i].is_ref_counted = false;
+			chunk[i].next_free = slot_max + i;
 		}
-		slot_max = new_slot_max;
+		slot_chunks[slot_max >> OBJECTDB_CHUNK_BITS].store(chunk, std::memory_order_release);
+		slot_max += OBJECTDB_CHUNK_SIZE;
 	}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+	uint32_t slot = _get_slot(slot_count).next_free;
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (object_slot.object.load(std::memory_order_relaxed) != nullptr) {
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+		ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.is_ref_counted = p_object->is_ref_counted();
 	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
 	if (unlikely(validator_counter == 0)) {
 		validator_counter = 1;
 	}
-	object_slots[slot].validator = validator_counter;
+	object_slot.validator.store(validator_counter, std::memory_order_release);
 
 	uint64_t id = validator_counter;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
@@ -2544,17 +2611,19 @@ void ObjectDB::remove_instance(Object *p_object) {
 
 	spin_lock.lock();
 
+	ObjectSlot &object_slot = _get_slot(slot);
+
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
+	if (object_slot.object.load(std::memory_order_relaxed) != p_object) {
 		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
+		ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	}
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
+		if (object_slot.validator.load(std::memory_order_relaxed) != validator) {
 			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
+			ERR_FAIL_COND(object_slot.validator.load(std::memory_order_relaxed) != validator);
 		}
 	}
 
@@ -2562,11 +2631,11 @@ void ObjectDB::remove_instance(Object *p_object) {
 	//decrease slot count
 	slot_count--;
 	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
-	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	_get_slot(slot_count).next_free = slot;
+	//invalidate first, so checks against it fail, including lookups already reading the slot
+	object_slot.validator.store(0, std::memory_order_relaxed);
+	object_slot.is_ref_counted = false;
+	object_slot.object.store(nullptr, std::memory_order_release);
 
 	spin_lock.unlock();
 }
@@ -2589,8 +2658,9 @@ void ObjectDB::cleanup() {
 			Callable::CallError call_error;
 
 			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+				const ObjectSlot &object_slot = _get_slot(i);
+				if (object_slot.validator.load(std::memory_order_relaxed)) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2603,7 +2673,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (object_slot.validator.load(std::memory_order_relaxed) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slot.is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2614,9 +2684,10 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
+	for (uint32_t i = 0; i < slot_max; i += OBJECTDB_CHUNK_SIZE) {
+		memfree(slot_chunks[i >> OBJECTDB_CHUNK_BITS].exchange(nullptr));
 	}
+	slot_max = 0;
 
 	spin_lock.unlock();
 }
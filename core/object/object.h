@@ -635,10 +635,25 @@ private:
 			int reference_count = 0;
 			Connection conn;
 			List<Connection>::Element *cE = nullptr;
+			// Position of this connection in dispatch.
+			uint32_t dispatch_index = 0;
+		};
+
+		// A connection as called by emit_signalp().
+		struct Dispatch {
+			Callable callable;
+			uint32_t flags = 0;
+			// Native method of a standard callable, called directly unless the target has a script.
+			MethodBind *method = nullptr;
 		};
 
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		// Connections in the order they were made. Emitting shares this array instead of
+		// copying the connections, and (dis)connecting meanwhile copies it on write.
+		// Disconnecting leaves an empty entry, which is compacted once they make up half of the array.
+		Vector<Dispatch> dispatch;
+		uint32_t dispatch_removed = 0;
 		bool removable = false;
 	};
 	friend struct _ObjectSignalLock;
@@ -678,6 +693,8 @@ private:
 	bool _has_user_signal(const StringName &p_name) const;
 	void _remove_user_signal(const StringName &p_name);
 	Error _emit_signal(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	static void _call_method_bind(Object *p_target, MethodBind *p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	static void _compact_signal_dispatch(SignalData *p_signal);
 	TypedArray<Dictionary> _get_signal_list() const;
 	TypedArray<Dictionary> _get_signal_connection_list(const StringName &p_signal) const;
 	TypedArray<Dictionary> _get_incoming_connections() const;
@@ -1078,20 +1095,31 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_BITS 24
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
-
-	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+#define OBJECTDB_CHUNK_BITS 12
+#define OBJECTDB_CHUNK_SIZE (uint32_t(1) << OBJECTDB_CHUNK_BITS)
+#define OBJECTDB_CHUNK_MASK (OBJECTDB_CHUNK_SIZE - 1)
+#define OBJECTDB_CHUNK_COUNT (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_CHUNK_BITS))
+
+	struct ObjectSlot {
+		// Lookups read these two without locking. Writers clear the validator
+		// before changing the object, and set it after.
+		std::atomic<uint64_t> validator;
+		std::atomic<Object *> object;
+		uint32_t next_free;
+		bool is_ref_counted;
 	};
 
-	static SpinLock spin_lock;
+	static SpinLock spin_lock; // Only taken to add or remove instances.
 	static uint32_t slot_count;
 	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
+	// Slots are allocated in chunks that never move, so lookups can't race a reallocation.
+	static std::atomic<ObjectSlot *> slot_chunks[OBJECTDB_CHUNK_COUNT];
 	static uint64_t validator_counter;
 
+	_FORCE_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return slot_chunks[p_slot >> OBJECTDB_CHUNK_BITS].load(std::memory_order_relaxed)[p_slot & OBJECTDB_CHUNK_MASK];
+	}
+
 	friend class Object;
 	friend void unregister_core_types();
 	static void cleanup();
@@ -1109,20 +1137,22 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
+		const ObjectSlot *chunk = slot_chunks[slot >> OBJECTDB_CHUNK_BITS].load(std::memory_order_acquire);
+		ERR_FAIL_NULL_V(chunk, nullptr); // This should never happen unless RID is corrupted.
+		const ObjectSlot &object_slot = chunk[slot & OBJECTDB_CHUNK_MASK];
 
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// Check again, the slot may have been freed and reused while reading the object.
+		if (unlikely(object_slot.validator.load(std::memory_order_relaxed) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
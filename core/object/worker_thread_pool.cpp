@@ -50,8 +50,63 @@ WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
 #ifdef THREADS_ENABLED
 thread_local WorkerThreadPool::UnlockableLocks WorkerThreadPool::unlockable_locks[MAX_UNLOCKABLE_LOCKS];
+thread_local WorkerThreadPool::ThreadData *WorkerThreadPool::current_thread_data = nullptr;
 #endif
 
+bool WorkerThreadPool::LocalQueue::push(Task *p_task) {
+	int64_t b = bottom.load(std::memory_order_relaxed);
+	int64_t t = top.load(std::memory_order_acquire);
+	if (b - t >= CAPACITY) {
+		return false;
+	}
+	buffer[b & (CAPACITY - 1)].store(p_task, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::LocalQueue::pop() {
+	int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = top.load(std::memory_order_relaxed);
+	if (t > b) {
+		// Empty.
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Task *task = buffer[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (t == b) {
+		// Last one, race thieves for it.
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			task = nullptr;
+		}
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::LocalQueue::steal() {
+	int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = bottom.load(std::memory_order_acquire);
+	if (t >= b) {
+		return nullptr;
+	}
+
+	Task *task = buffer[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr; // Lost the race to the owner or another thief.
+	}
+	return task;
+}
+
+bool WorkerThreadPool::LocalQueue::is_empty() const {
+	int64_t t = top.load(std::memory_order_acquire);
+	return bottom.load(std::memory_order_acquire) <= t;
+}
+
 void WorkerThreadPool::_process_task(Task *p_task) {
 #ifdef THREADS_ENABLED
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
@@ -88,6 +143,12 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	bool low_priority = p_task->low_priority;
 #endif
 
+	// Run with the mod sandbox the task was queued from. Group tasks may be
+	// freed below, so the scope keeps its own reference.
+	ModSecurity::Scope sandbox_scope(p_task->sandbox);
+
+	LocalVector<Task *> released; // Dependents that can be queued now.
+
 	if (p_task->group) {
 		// Handling a group
 		bool do_post = false;
@@ -114,13 +175,22 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			}
 		}
 
+		if (unlikely(p_task->group->max == 0)) {
+			do_post = true; // Empty group that had to wait for its dependencies.
+		}
+
 		if (do_post && p_task->template_userdata) {
 			memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
 		}
 
 		if (do_post) {
+			{
+				// Dependents are registered under the task mutex, so they can't be missed.
+				MutexLock task_lock(task_mutex);
+				p_task->group->completed.set_to(true);
+				_release_dependents(p_task->group->dependents, released);
+			}
 			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -148,6 +218,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
+		_release_dependents(p_task->dependents, released);
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -179,15 +250,26 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 	MessageQueue::set_thread_singleton_override(call_queue_backup);
 #endif
+
+	if (!released.is_empty()) {
+		_post_released_tasks(released);
+	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
+#ifdef THREADS_ENABLED
+	current_thread_data = thread_data;
+#endif
 
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+		if (thread_data->local_queue) {
+			// Work stealing, local and stolen tasks don't need the task mutex.
+			task_to_process = thread_data->pool->_take_local_task(thread_data);
+		}
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -201,9 +283,24 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				thread_data->signaled = false;
 
 				if (!thread_data->pool->task_queue.first()) {
+					if (thread_data->local_queue) {
+						// Announce sleeping before checking the local queues one last time,
+						// so a thread pushing a task either sees this one sleeping or leaves
+						// the task where it is found here.
+						thread_data->pool->num_sleeping_threads.fetch_add(1, std::memory_order_seq_cst);
+						task_to_process = thread_data->pool->_take_local_task(thread_data);
+						if (task_to_process) {
+							thread_data->pool->num_sleeping_threads.fetch_sub(1, std::memory_order_relaxed);
+							break;
+						}
+					}
+
 					// There wasn't a task available yet.
 					// Let's wait for the next notification, then recheck.
 					thread_data->cond_var.wait(lock);
+					if (thread_data->local_queue) {
+						thread_data->pool->num_sleeping_threads.fetch_sub(1, std::memory_order_relaxed);
+					}
 					continue;
 				}
 
@@ -262,6 +359,78 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 	_notify_threads(caller_pool_thread, to_process, to_promote);
 }
 
+WorkerThreadPool::ThreadData *WorkerThreadPool::_get_local_thread_data(bool p_high_priority, bool p_pump_task) const {
+#ifdef THREADS_ENABLED
+	// Low priority tasks go through the shared queue, which is where their thread budget is accounted for.
+	if (scheduler == SCHEDULER_WORK_STEALING && p_high_priority && !p_pump_task && current_thread_data && current_thread_data->pool == this) {
+		return current_thread_data;
+	}
+#endif
+	return nullptr;
+}
+
+void WorkerThreadPool::_push_local_tasks(ThreadData *p_thread_data, Task **p_tasks, uint32_t p_count) {
+	uint32_t pushed = 0;
+	for (; pushed < p_count; pushed++) {
+		p_tasks[pushed]->low_priority = false;
+		if (!p_thread_data->local_queue->push(p_tasks[pushed])) {
+			break;
+		}
+	}
+
+	if (pushed) {
+		// Pairs with sleeping threads announcing themselves before their last check.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (num_sleeping_threads.load(std::memory_order_relaxed)) {
+			MutexLock lock(task_mutex);
+			_notify_threads(p_thread_data, pushed, 0);
+		}
+	}
+
+	if (pushed < p_count) {
+		// Local queue is full.
+		MutexLock<BinaryMutex> lock(task_mutex);
+		_post_tasks(p_tasks + pushed, p_count - pushed, true, lock, false);
+	}
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_take_local_task(ThreadData *p_thread_data) {
+	Task *task = p_thread_data->local_queue->pop();
+	if (task) {
+		return task;
+	}
+
+	// Steal from the other threads, starting at a random one so thieves don't pile up on the same victim.
+	uint32_t &seed = p_thread_data->steal_seed;
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &victim = threads[(seed + i) % thread_count];
+		if (&victim == p_thread_data || !victim.local_queue) {
+			continue;
+		}
+		do {
+			task = victim.local_queue->steal();
+		} while (!task && !victim.local_queue->is_empty());
+		if (task) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (const ThreadData &th : threads) {
+		if (th.local_queue && !th.local_queue->is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
 	uint32_t to_process = p_process_count;
 	uint32_t to_promote = p_promote_count;
@@ -338,44 +507,108 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
-	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
+uint32_t WorkerThreadPool::_add_dependencies(Span<TaskID> p_dependencies, TaskID p_self, bool p_high_priority, Task **p_tasks, uint32_t p_count) {
+	uint32_t pending = 0;
+	for (TaskID dependency : p_dependencies) {
+		LocalVector<Task *> *dependents = nullptr;
+		if (Task **taskp = tasks.getptr(dependency)) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else if (Group **groupp = groups.getptr(dependency)) {
+			if (!(*groupp)->completed.is_set()) {
+				dependents = &(*groupp)->dependents;
+			}
+		} else {
+			// IDs are never reused, so an older one that's gone was already waited for.
+			ERR_CONTINUE_MSG(dependency <= 0 || dependency >= p_self, vformat("Invalid task or group dependency: %d.", dependency));
+		}
+
+		if (dependents) {
+			for (uint32_t i = 0; i < p_count; i++) {
+				dependents->push_back(p_tasks[i]);
+			}
+			pending++;
+		}
+	}
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_tasks[i]->pending_dependencies = pending;
+		p_tasks[i]->low_priority = !p_high_priority; // Kept until queued.
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready) {
+	for (Task *dependent : p_dependents) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			r_ready.push_back(dependent);
+		}
+	}
+	p_dependents.clear();
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
+void WorkerThreadPool::_post_released_tasks(const LocalVector<Task *> &p_tasks) {
 	MutexLock<BinaryMutex> lock(task_mutex);
+	for (Task *task : p_tasks) {
+		_post_tasks(&task, 1, !task->low_priority, lock, false);
+	}
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
 
-	// Get a free task
-	Task *task = task_allocator.alloc();
-	TaskID id = last_task++;
-	task->self = id;
-	task->callable = p_callable;
-	task->native_func = p_func;
-	task->native_func_userdata = p_userdata;
-	task->description = p_description;
-	task->template_userdata = p_template_userdata;
-	task->is_pump_task = p_pump_task;
-	tasks.insert(id, task);
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task, Span<TaskID> p_dependencies) {
+	ThreadData *local_thread_data = _get_local_thread_data(p_high_priority, p_pump_task);
+	Task *task = nullptr;
+	TaskID id = INVALID_TASK_ID;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
+
+		// Get a free task
+		task = task_allocator.alloc();
+		id = last_task++;
+		task->self = id;
+		task->callable = p_callable;
+		task->native_func = p_func;
+		task->native_func_userdata = p_userdata;
+		task->description = p_description;
+		task->template_userdata = p_template_userdata;
+		task->is_pump_task = p_pump_task;
+		task->sandbox = ModSecurity::get_current_sandbox();
+		uint32_t pending_dependencies = p_dependencies.is_empty() ? 0 : _add_dependencies(p_dependencies, id, p_high_priority, &task, 1);
+		tasks.insert(id, task);
 
 #ifdef THREADS_ENABLED
-	if (p_pump_task) {
-		pump_task_count++;
-		int thread_count = get_thread_count();
-		if (pump_task_count >= thread_count) {
-			print_verbose(vformat("A greater number of dedicated threads were requested (%d) than threads available (%d). Please increase the number of available worker task threads. Recovering this session by spawning more worker task threads.", pump_task_count + 1, thread_count)); // +1 because we want to keep a Thread without any pump tasks free.
+		if (p_pump_task) {
+			pump_task_count++;
+			int thread_count = get_thread_count();
+			if (pump_task_count >= thread_count) {
+				print_verbose(vformat("A greater number of dedicated threads were requested (%d) than threads available (%d). Please increase the number of available worker task threads. Recovering this session by spawning more worker task threads.", pump_task_count + 1, thread_count)); // +1 because we want to keep a Thread without any pump tasks free.
+
+				// Re-sizing implies relocation, which is not supported for this array.
+				CRASH_COND_MSG(thread_count + 1 > (int)threads.get_capacity(), "Reserve trick for worker thread pool failed. Crashing.");
+				threads.resize_initialized(thread_count + 1);
+				_start_thread(thread_count);
+			}
+		}
+#endif
+
+		if (pending_dependencies) {
+			return id; // Queued by the last dependency to complete.
+		}
 
-			// Re-sizing implies relocation, which is not supported for this array.
-			CRASH_COND_MSG(thread_count + 1 > (int)threads.get_capacity(), "Reserve trick for worker thread pool failed. Crashing.");
-			threads.resize_initialized(thread_count + 1);
-			threads[thread_count].index = thread_count;
-			threads[thread_count].pool = this;
-			threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
-			thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
+		if (!local_thread_data) {
+			_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+			return id;
 		}
 	}
-#endif
 
-	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+	// Outside of the task mutex, that is the point of pushing locally.
+	_push_local_tasks(local_thread_data, &task, 1);
 
 	return id;
 }
@@ -534,7 +767,11 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			if (p_caller_pool_thread->local_queue) {
+				task_to_process = _take_local_task(p_caller_pool_thread);
+			}
+
+			if (!task_to_process && p_caller_pool_thread->pool->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -544,6 +781,15 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
+			if (!task_to_process && p_caller_pool_thread->local_queue) {
+				// Same handshake as idle threads, see _thread_function().
+				num_sleeping_threads.fetch_add(1, std::memory_order_seq_cst);
+				task_to_process = _take_local_task(p_caller_pool_thread);
+				if (task_to_process) {
+					num_sleeping_threads.fetch_sub(1, std::memory_order_relaxed);
+				}
+			}
+
 			if (!task_to_process) {
 				p_caller_pool_thread->awaited_task = p_task;
 
@@ -555,6 +801,9 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				p_caller_pool_thread->cond_var.wait(lock);
 
 				p_caller_pool_thread->awaited_task = nullptr;
+				if (p_caller_pool_thread->local_queue) {
+					num_sleeping_threads.fetch_sub(1, std::memory_order_relaxed);
+				}
 			}
 		}
 
@@ -587,7 +836,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -650,55 +899,72 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
 	}
 
-	MutexLock<BinaryMutex> lock(task_mutex);
+	ThreadData *local_thread_data = _get_local_thread_data(p_high_priority, false);
+	Task **tasks_posted = nullptr;
+	GroupID id = INVALID_TASK_ID;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
+
+		Group *group = group_allocator.alloc();
+		id = last_task++;
+		group->max = p_elements;
+		group->self = id;
+
+		if (p_elements == 0 && p_dependencies.is_empty()) {
+			// Should really not call it with zero Elements, but at least it should work.
+			group->completed.set_to(true);
+			group->done_semaphore.post();
+			group->tasks_used = 0;
+			p_tasks = 0;
+			if (p_template_userdata) {
+				memdelete(p_template_userdata);
+			}
+
+		} else {
+			if (p_elements == 0) {
+				p_tasks = 1; // Still has to complete after its dependencies.
+			}
+			group->tasks_used = p_tasks;
+			tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+			for (int i = 0; i < p_tasks; i++) {
+				Task *task = task_allocator.alloc();
+				task->native_group_func = p_func;
+				task->native_func_userdata = p_userdata;
+				task->description = p_description;
+				task->group = group;
+				task->callable = p_callable;
+				task->template_userdata = p_template_userdata;
+				task->sandbox = ModSecurity::get_current_sandbox();
+				tasks_posted[i] = task;
+				// No task ID is used.
+			}
+		}
 
-	Group *group = group_allocator.alloc();
-	GroupID id = last_task++;
-	group->max = p_elements;
-	group->self = id;
+		uint32_t pending_dependencies = p_dependencies.is_empty() ? 0 : _add_dependencies(p_dependencies, id, p_high_priority, tasks_posted, p_tasks);
+		groups[id] = group;
 
-	Task **tasks_posted = nullptr;
-	if (p_elements == 0) {
-		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
-		group->tasks_used = 0;
-		p_tasks = 0;
-		if (p_template_userdata) {
-			memdelete(p_template_userdata);
+		if (pending_dependencies) {
+			return id; // Queued by the last dependency to complete.
 		}
 
-	} else {
-		group->tasks_used = p_tasks;
-		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
-		for (int i = 0; i < p_tasks; i++) {
-			Task *task = task_allocator.alloc();
-			task->native_group_func = p_func;
-			task->native_func_userdata = p_userdata;
-			task->description = p_description;
-			task->group = group;
-			task->callable = p_callable;
-			task->template_userdata = p_template_userdata;
-			tasks_posted[i] = task;
-			// No task ID is used.
+		if (!local_thread_data) {
+			_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+			return id;
 		}
 	}
 
-	groups[id] = group;
-
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
-
+	_push_local_tasks(local_thread_data, tasks_posted, p_tasks);
 	return id;
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
-	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
@@ -806,10 +1072,11 @@ void WorkerThreadPool::thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {
 }
 #endif
 
-void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio, Scheduler p_scheduler) {
 	ERR_FAIL_COND(threads.size() > 0);
 
 	runlevel = RUNLEVEL_NORMAL;
+	scheduler = p_scheduler;
 
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
@@ -817,7 +1084,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
 
-	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority.", p_thread_count, max_low_priority_threads));
+	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority%s.", p_thread_count, max_low_priority_threads, scheduler == SCHEDULER_WORK_STEALING ? ", work stealing" : ""));
 
 #ifdef THREADS_ENABLED
 	// Reserve 5 threads in case we need separate threads for 1) 2D physics 2) 3D physics 3) rendering 4) GPU texture compression, 5) all other tasks.
@@ -827,11 +1094,20 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	threads.resize(p_thread_count);
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
-		threads[i].index = i;
-		threads[i].pool = this;
-		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
-		thread_ids.insert(threads[i].thread.get_id(), i);
+		_start_thread(i);
+	}
+}
+
+void WorkerThreadPool::_start_thread(uint32_t p_index) {
+	ThreadData &th = threads[p_index];
+	th.index = p_index;
+	th.pool = this;
+	if (scheduler == SCHEDULER_WORK_STEALING) {
+		th.local_queue = memnew(LocalQueue);
+		th.steal_seed = p_index + 1; // Must not be zero.
 	}
+	th.thread.start(&WorkerThreadPool::_thread_function, &th);
+	thread_ids.insert(th.thread.get_id(), p_index);
 }
 
 void WorkerThreadPool::exit_languages_threads() {
@@ -881,6 +1157,13 @@ void WorkerThreadPool::finish() {
 		}
 	}
 
+	for (ThreadData &data : threads) {
+		if (data.local_queue) {
+			memdelete(data.local_queue);
+			data.local_queue = nullptr;
+		}
+	}
+
 	threads.clear();
 }
 
@@ -897,13 +1180,16 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_caller_group_id"), &WorkerThreadPool::get_caller_group_id);
 }
 
-WorkerThreadPool *WorkerThreadPool::get_named_pool(const StringName &p_name) {
+WorkerThreadPool *WorkerThreadPool::get_named_pool(const StringName &p_name, Scheduler p_scheduler) {
 	WorkerThreadPool **pool_ptr = named_pools.getptr(p_name);
 	if (pool_ptr) {
+		if ((*pool_ptr)->scheduler != p_scheduler) {
+			WARN_PRINT(vformat("Named WorkerThreadPool '%s' already exists with another scheduler. The requested scheduler is ignored.", p_name));
+		}
 		return *pool_ptr;
 	} else {
 		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
-		pool->init();
+		pool->init(-1, 0.3, p_scheduler);
 		named_pools[p_name] = pool;
 		return pool;
 	}
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/config/mod_security.h"
 #include "core/os/condition_variable.h"
 #include "core/os/memory.h"
 #include "core/os/os.h"
@@ -40,6 +41,7 @@
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/span.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -51,6 +53,11 @@ public:
 	typedef int64_t TaskID;
 	typedef int64_t GroupID;
 
+	enum Scheduler {
+		SCHEDULER_SHARED_QUEUE, // Every task goes through the pool's queue.
+		SCHEDULER_WORK_STEALING, // Tasks posted from pool threads stay in their own queue, idle threads steal them.
+	};
+
 private:
 	struct Task;
 
@@ -69,6 +76,7 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<Task *> dependents; // Queued once this group completes.
 	};
 
 	struct Task {
@@ -89,6 +97,9 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		Ref<ModSandbox> sandbox; // Mod sandbox of the thread that queued the task, if any.
+		uint32_t pending_dependencies = 0; // Not queued until it drops to zero.
+		LocalVector<Task *> dependents; // Queued once this task completes.
 
 		void free_template_userdata();
 		Task() :
@@ -109,6 +120,21 @@ private:
 
 	BinaryMutex task_mutex;
 
+	// Fixed size Chase-Lev deque. Only the owning thread pushes and pops,
+	// any thread may steal. Pushing fails when full, then the shared queue is used.
+	struct LocalQueue {
+		static const int64_t CAPACITY = 1024;
+
+		std::atomic<int64_t> top = 0;
+		std::atomic<int64_t> bottom = 0;
+		std::atomic<Task *> buffer[CAPACITY];
+
+		bool push(Task *p_task);
+		Task *pop();
+		Task *steal();
+		bool is_empty() const;
+	};
+
 	struct ThreadData {
 		static Task *const YIELDING; // Too bad constexpr doesn't work here.
 
@@ -123,6 +149,8 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		LocalQueue *local_queue = nullptr; // Only with SCHEDULER_WORK_STEALING.
+		uint32_t steal_seed = 0;
 
 		ThreadData() :
 				signaled(false),
@@ -172,9 +200,22 @@ private:
 	uint64_t last_task = 1;
 	int pump_task_count = 0;
 
+	Scheduler scheduler = SCHEDULER_SHARED_QUEUE;
+	std::atomic<uint32_t> num_sleeping_threads = 0; // Only tracked with SCHEDULER_WORK_STEALING.
+
 	static HashMap<StringName, WorkerThreadPool *> named_pools;
 
+#ifdef THREADS_ENABLED
+	static thread_local ThreadData *current_thread_data;
+#endif
+
 	static void _thread_function(void *p_user);
+	void _start_thread(uint32_t p_index);
+
+	ThreadData *_get_local_thread_data(bool p_high_priority, bool p_pump_task) const;
+	void _push_local_tasks(ThreadData *p_thread_data, Task **p_tasks, uint32_t p_count);
+	Task *_take_local_task(ThreadData *p_thread_data);
+	bool _has_local_tasks() const;
 
 	void _process_task(Task *task);
 
@@ -183,6 +224,10 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	uint32_t _add_dependencies(Span<TaskID> p_dependencies, TaskID p_self, bool p_high_priority, Task **p_tasks, uint32_t p_count);
+	void _release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_ready);
+	void _post_released_tasks(const LocalVector<Task *> &p_tasks);
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -194,8 +239,8 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false, Span<TaskID> p_dependencies = Span<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, Span<TaskID> p_dependencies = Span<TaskID>());
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -233,16 +278,20 @@ protected:
 	static void _bind_methods();
 
 public:
+	// Dependencies are IDs of tasks and groups of this pool. The new task or group is
+	// only queued once all of them have completed, so a chain of stages can be posted
+	// at once and only the last one waited for. Dependencies must still be waited for
+	// (or have been already) to release them.
 	template <typename C, typename M, typename U>
-	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>()) {
 		typedef TaskUserData<C, M, U> TUD;
 		TUD *ud = memnew(TUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description);
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, false, p_dependencies);
 	}
-	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String(), bool p_pump_task = false);
 	TaskID add_task_bind(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
@@ -253,15 +302,15 @@ public:
 	void notify_yield_over(TaskID p_task_id);
 
 	template <typename C, typename M, typename U>
-	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+	GroupID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>()) {
 		typedef GroupUserData<C, M, U> GroupUD;
 		GroupUD *ud = memnew(GroupUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description);
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
 	}
-	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String(), Span<TaskID> p_dependencies = Span<TaskID>());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
@@ -276,7 +325,8 @@ public:
 	}
 
 	// Note: Do not use this unless you know what you are doing, and it is absolutely necessary. Main thread pool (`get_singleton()`) should be preferred instead.
-	static WorkerThreadPool *get_named_pool(const StringName &p_name);
+	// The scheduler only applies when the call creates the pool.
+	static WorkerThreadPool *get_named_pool(const StringName &p_name, Scheduler p_scheduler = SCHEDULER_SHARED_QUEUE);
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	int get_thread_index() const;
@@ -295,7 +345,9 @@ public:
 	static void thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {}
 #endif
 
-	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3);
+	Scheduler get_scheduler() const { return scheduler; }
+
+	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3, Scheduler p_scheduler = SCHEDULER_SHARED_QUEUE);
 	void exit_languages_threads();
 	void finish();
 	WorkerThreadPool(bool p_singleton = true);
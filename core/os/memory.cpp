@@ -30,6 +30,7 @@
 
 #include "memory.h"
 
+#include "core/os/small_object_allocator.h"
 #include "core/profiling/profiling.h"
 #include "core/templates/safe_refcount.h"
 
@@ -62,6 +63,46 @@ static SafeNumeric<uint64_t> _current_mem_usage;
 static SafeNumeric<uint64_t> _max_mem_usage;
 #endif
 
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+// Blocks always have the size header then, it tells which allocator they came from.
+static void *_alloc_block(size_t p_size, bool p_zeroed) {
+	if (!SmallObjectAllocator::is_small(p_size)) {
+		return p_zeroed ? calloc(1, p_size) : malloc(p_size);
+	}
+	void *mem = SmallObjectAllocator::alloc(p_size);
+	if (p_zeroed && mem) {
+		memset(mem, 0, p_size);
+	}
+	return mem;
+}
+
+static void _free_block(void *p_mem, size_t p_size) {
+	if (SmallObjectAllocator::is_small(p_size)) {
+		SmallObjectAllocator::free(p_mem, p_size);
+	} else {
+		free(p_mem);
+	}
+}
+
+static void *_realloc_block(void *p_mem, size_t p_prev_size, size_t p_size) {
+	bool prev_small = SmallObjectAllocator::is_small(p_prev_size);
+	bool small = SmallObjectAllocator::is_small(p_size);
+	if (!prev_small && !small) {
+		return realloc(p_mem, p_size);
+	}
+	if (prev_small && small && SmallObjectAllocator::get_size_class(p_prev_size) == SmallObjectAllocator::get_size_class(p_size)) {
+		return p_mem;
+	}
+
+	void *mem = _alloc_block(p_size, false);
+	if (mem) {
+		memcpy(mem, p_mem, MIN(p_prev_size, p_size));
+		_free_block(p_mem, p_prev_size);
+	}
+	return mem;
+}
+#endif
+
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 	DEV_ASSERT(is_power_of_2(p_alignment));
 
@@ -98,18 +139,22 @@ void Memory::free_aligned_static(void *p_memory) {
 
 template <bool p_ensure_zero>
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_OBJECT_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
 	void *mem;
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+	mem = _alloc_block(p_bytes + DATA_OFFSET, p_ensure_zero);
+#else
 	if constexpr (p_ensure_zero) {
 		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
 	} else {
 		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
 	}
+#endif
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 	GodotProfileAlloc(mem, p_bytes + (prepad ? DATA_OFFSET : 0));
@@ -140,7 +185,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_OBJECT_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -149,6 +194,9 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+		const uint64_t prev_bytes = *s;
+#endif
 
 #ifdef DEBUG_ENABLED
 		if (p_bytes > *s) {
@@ -161,13 +209,21 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 		if (p_bytes == 0) {
 			GodotProfileFree(mem);
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+			_free_block(mem, prev_bytes + DATA_OFFSET);
+#else
 			free(mem);
+#endif
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
 			GodotProfileFree(mem);
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+			mem = (uint8_t *)_realloc_block(mem, prev_bytes + DATA_OFFSET, p_bytes + DATA_OFFSET);
+#else
 			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+#endif
 			ERR_FAIL_NULL_V(mem, nullptr);
 			GodotProfileAlloc(mem, p_bytes + DATA_OFFSET);
 
@@ -193,7 +249,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(SMALL_OBJECT_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -208,7 +264,11 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 #endif
 
 		GodotProfileFree(mem);
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+		_free_block(mem, *(uint64_t *)(mem + SIZE_OFFSET) + DATA_OFFSET);
+#else
 		free(mem);
+#endif
 	} else {
 		GodotProfileFree(mem);
 		free(mem);
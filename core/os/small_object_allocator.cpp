@@ -0,0 +1,201 @@
+/**************************************************************************/
+/*  small_object_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_object_allocator.h"
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+
+#include "core/os/mutex.h"
+
+#include <cstdlib>
+
+namespace {
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+constexpr size_t SLAB_SIZE = 64 * 1024;
+constexpr size_t BLOCK_ALIGN = 16;
+
+struct CentralClass {
+	BinaryMutex mutex;
+	FreeBlock *free_list = nullptr;
+	uint8_t *slab_cursor = nullptr;
+	uint8_t *slab_end = nullptr;
+};
+
+CentralClass central[SmallObjectAllocator::SIZE_CLASS_COUNT];
+
+// Must be trivial, so it's usable until the very end of the thread.
+struct ThreadCache {
+	FreeBlock *free_list[SmallObjectAllocator::SIZE_CLASS_COUNT];
+	uint32_t count[SmallObjectAllocator::SIZE_CLASS_COUNT];
+	bool initialized;
+	bool exited;
+};
+
+thread_local ThreadCache thread_cache;
+
+// How many blocks move between a thread and the central heap at once.
+_FORCE_INLINE_ uint32_t get_batch_size(uint32_t p_class) {
+	return CLAMP(16 * 1024 / SmallObjectAllocator::get_class_size(p_class), 8u, 64u);
+}
+
+// Takes up to `p_count` blocks from the central heap, linked through their first bytes.
+FreeBlock *central_take(uint32_t p_class, uint32_t p_count, uint32_t &r_taken) {
+	CentralClass &cc = central[p_class];
+	MutexLock lock(cc.mutex);
+
+	FreeBlock *first = nullptr;
+	r_taken = 0;
+	while (r_taken < p_count && cc.free_list) {
+		FreeBlock *block = cc.free_list;
+		cc.free_list = block->next;
+		block->next = first;
+		first = block;
+		r_taken++;
+	}
+
+	const size_t block_size = SmallObjectAllocator::get_class_size(p_class);
+	while (r_taken < p_count) {
+		if (cc.slab_cursor + block_size > cc.slab_end) {
+			uint8_t *slab = (uint8_t *)malloc(SLAB_SIZE);
+			if (!slab) {
+				break;
+			}
+			cc.slab_cursor = (uint8_t *)(((uintptr_t)slab + BLOCK_ALIGN - 1) & ~(uintptr_t)(BLOCK_ALIGN - 1));
+			cc.slab_end = slab + SLAB_SIZE;
+		}
+		FreeBlock *block = (FreeBlock *)cc.slab_cursor;
+		cc.slab_cursor += block_size;
+		block->next = first;
+		first = block;
+		r_taken++;
+	}
+	return first;
+}
+
+void central_give(uint32_t p_class, FreeBlock *p_first, FreeBlock *p_last) {
+	CentralClass &cc = central[p_class];
+	MutexLock lock(cc.mutex);
+	p_last->next = cc.free_list;
+	cc.free_list = p_first;
+}
+
+void flush_thread_cache() {
+	for (uint32_t i = 0; i < SmallObjectAllocator::SIZE_CLASS_COUNT; i++) {
+		FreeBlock *first = thread_cache.free_list[i];
+		if (!first) {
+			continue;
+		}
+		FreeBlock *last = first;
+		while (last->next) {
+			last = last->next;
+		}
+		central_give(i, first, last);
+		thread_cache.free_list[i] = nullptr;
+		thread_cache.count[i] = 0;
+	}
+}
+
+// Gives the cached blocks back when the thread exits. Allocations after that go
+// straight to the central heap.
+struct ThreadCacheFlusher {
+	bool active = false;
+	~ThreadCacheFlusher() {
+		flush_thread_cache();
+		thread_cache.exited = true;
+	}
+};
+
+thread_local ThreadCacheFlusher thread_cache_flusher;
+
+} // namespace
+
+void *SmallObjectAllocator::alloc(size_t p_size) {
+	const uint32_t size_class = get_size_class(p_size);
+	ThreadCache &cache = thread_cache;
+
+	if (unlikely(!cache.initialized)) {
+		cache.initialized = true;
+		thread_cache_flusher.active = true; // Registers the destructor for this thread.
+	}
+
+	if (unlikely(cache.exited)) {
+		uint32_t taken = 0;
+		return central_take(size_class, 1, taken);
+	}
+
+	FreeBlock *block = cache.free_list[size_class];
+	if (unlikely(!block)) {
+		uint32_t taken = 0;
+		block = central_take(size_class, get_batch_size(size_class), taken);
+		if (!block) {
+			return nullptr;
+		}
+		cache.count[size_class] = taken;
+	}
+
+	cache.free_list[size_class] = block->next;
+	cache.count[size_class]--;
+	return block;
+}
+
+void SmallObjectAllocator::free(void *p_ptr, size_t p_size) {
+	const uint32_t size_class = get_size_class(p_size);
+	ThreadCache &cache = thread_cache;
+	FreeBlock *block = (FreeBlock *)p_ptr;
+
+	if (unlikely(!cache.initialized || cache.exited)) {
+		// Freed by a thread that never allocated, or is exiting.
+		central_give(size_class, block, block);
+		return;
+	}
+
+	block->next = cache.free_list[size_class];
+	cache.free_list[size_class] = block;
+	cache.count[size_class]++;
+
+	const uint32_t batch = get_batch_size(size_class);
+	if (unlikely(cache.count[size_class] >= batch * 2)) {
+		// Too many cached, give a batch back so other threads can use them.
+		FreeBlock *first = cache.free_list[size_class];
+		FreeBlock *last = first;
+		for (uint32_t i = 1; i < batch; i++) {
+			last = last->next;
+		}
+		cache.free_list[size_class] = last->next;
+		cache.count[size_class] -= batch;
+		central_give(size_class, first, last);
+	}
+}
+
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
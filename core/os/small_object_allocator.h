@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*  small_object_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+#ifdef SMALL_OBJECT_ALLOCATOR_ENABLED
+
+// Allocator for the small blocks behind Memory::alloc_static(), enabled with the
+// `small_object_allocator` build option. Each thread keeps a free list per size
+// class and exchanges blocks in batches with a central heap, which carves them
+// out of large slabs. Most allocations and frees don't take any lock.
+// Memory is kept for reuse, slabs are never given back to the system.
+class SmallObjectAllocator {
+public:
+	static constexpr size_t MAX_SIZE = 1024;
+
+	// 16 byte steps up to 256, then 64 byte steps up to MAX_SIZE.
+	static constexpr uint32_t SIZE_CLASS_COUNT = 16 + 12;
+
+	_FORCE_INLINE_ static bool is_small(size_t p_size) { return p_size <= MAX_SIZE; }
+	_FORCE_INLINE_ static uint32_t get_size_class(size_t p_size) {
+		if (p_size <= 256) {
+			return p_size <= 16 ? 0 : (p_size + 15) / 16 - 1;
+		}
+		return 15 + (p_size - 256 + 63) / 64;
+	}
+	_FORCE_INLINE_ static size_t get_class_size(uint32_t p_class) {
+		return p_class < 16 ? (p_class + 1) * 16 : 256 + (p_class - 15) * 64;
+	}
+
+	// Sizes must be small, and the size given when freeing must be in the same class.
+	static void *alloc(size_t p_size);
+	static void free(void *p_ptr, size_t p_size);
+};
+
+#endif // SMALL_OBJECT_ALLOCATOR_ENABLED
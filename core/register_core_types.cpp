@@ -31,6 +31,7 @@
 #include "register_core_types.h"
 
 #include "core/config/engine.h"
+#include "core/config/mod_security.h"
 #include "core/config/project_settings.h"
 #include "core/core_bind.h"
 #include "core/crypto/aes_context.h"
@@ -46,6 +47,7 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/dtls_server.h"
+#include "core/io/file_access_async.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
@@ -111,6 +113,7 @@ static CoreBind::Geometry2D *_geometry_2d = nullptr;
 static CoreBind::Geometry3D *_geometry_3d = nullptr;
 
 static WorkerThreadPool *worker_thread_pool = nullptr;
+static FileAccessAsync *file_access_async = nullptr;
 
 extern Mutex _global_mutex;
 
@@ -336,6 +339,7 @@ void register_core_types() {
 	GDREGISTER_NATIVE_STRUCT(ScriptLanguageExtensionProfilingInfo, "StringName signature;uint64_t call_count;uint64_t total_time;uint64_t self_time");
 
 	worker_thread_pool = memnew(WorkerThreadPool);
+	file_access_async = memnew(FileAccessAsync);
 
 	OS::get_singleton()->benchmark_end_measure("Core", "Register Types");
 }
@@ -349,6 +353,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF("threading/worker_pool/work_stealing", false);
 }
 
 void register_early_core_singletons() {
@@ -407,6 +412,7 @@ void unregister_core_types() {
 
 	// Destroy singletons in reverse order to ensure dependencies are not broken.
 
+	memdelete(file_access_async);
 	memdelete(worker_thread_pool);
 
 	memdelete(_engine_debugger);
@@ -424,6 +430,8 @@ void unregister_core_types() {
 
 	memdelete(resource_uid);
 
+	ModSecurity::clear_mod_policies();
+
 	if (ip) {
 		memdelete(ip);
 	}
@@ -39,30 +39,127 @@ struct StringName::Table {
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	// Buckets are spread over shards, each with its own lock and allocator, so
+	// threads adding or freeing unrelated names rarely contend. Looking up an
+	// existing name takes no lock at all.
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	constexpr static uint32_t SHARD_MASK = SHARD_COUNT - 1;
+
+	struct Shard {
+		// Lock-free readers currently walking a chain of this shard. Unlinked
+		// entries are only freed when there are none, as they may still be on them.
+		std::atomic<uint32_t> readers = 0;
+		BinaryMutex mutex;
+		PagedAllocator<_Data, false, 256> allocator;
+		LocalVector<_Data *> retired;
+	};
+
+	static inline std::atomic<_Data *> table[TABLE_LEN];
+	static Shard shards[SHARD_COUNT];
+
+	// Returns a new reference to the entry, skipping entries that are being freed.
+	template <typename T>
+	static _Data *find(const T &p_name, uint32_t p_hash, uint32_t p_idx) {
+		_Data *data = table[p_idx].load(std::memory_order_acquire);
+		while (data) {
+			if (data->hash == p_hash && data->name == p_name && data->refcount.ref()) {
+				return data;
+			}
+			data = data->next.load(std::memory_order_acquire);
+		}
+		return nullptr;
+	}
+
+	template <typename T>
+	static _Data *intern(const T &p_name, uint32_t p_hash, bool p_static) {
+		const uint32_t idx = p_hash & TABLE_MASK;
+		Shard &shard = shards[idx & SHARD_MASK];
+
+		shard.readers.fetch_add(1, std::memory_order_seq_cst);
+		_Data *data = find(p_name, p_hash, idx);
+		shard.readers.fetch_sub(1, std::memory_order_release);
+
+		if (!data) {
+			MutexLock lock(shard.mutex);
+			data = find(p_name, p_hash, idx); // May have been added meanwhile.
+			if (!data) {
+				if (!shard.retired.is_empty()) {
+					// Good time to reuse entries retired while lookups were running.
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (shard.readers.load(std::memory_order_acquire) == 0) {
+						free_retired(shard);
+					}
+				}
+
+				data = shard.allocator.alloc();
+				data->name = p_name;
+				data->refcount.init();
+				data->static_count.set(p_static ? 1 : 0);
+				data->hash = p_hash;
+				data->prev = nullptr;
+#ifdef DEBUG_ENABLED
+				if (unlikely(debug_stringname)) {
+					// Keep in memory, force static.
+					data->refcount.ref();
+					data->static_count.increment();
+				}
+#endif
+
+				_Data *head = table[idx].load(std::memory_order_relaxed);
+				data->next.store(head, std::memory_order_relaxed);
+				if (head) {
+					head->prev = data;
+				}
+				table[idx].store(data, std::memory_order_release); // Publishes the entry.
+				return data;
+			}
+		}
+
+		// Exists.
+		if (p_static) {
+			data->static_count.increment();
+		}
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			data->debug_references++;
+		}
+#endif
+		return data;
+	}
+
+	// Must be called with the shard locked.
+	static void free_retired(Shard &p_shard) {
+		for (_Data *data : p_shard.retired) {
+			p_shard.allocator.free(data);
+		}
+		p_shard.retired.clear();
+	}
 };
 
+StringName::Table::Shard StringName::Table::shards[StringName::Table::SHARD_COUNT];
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
+		Table::table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (Table::Shard &shard : Table::shards) {
+		shard.mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
+			_Data *d = Table::table[i].load(std::memory_order_relaxed);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_relaxed);
 			}
 		}
 
@@ -86,8 +183,7 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
+		while (_Data *d = Table::table[i].load(std::memory_order_relaxed)) {
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -96,13 +192,18 @@ void StringName::cleanup() {
 				}
 			}
 
-			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+			Table::table[i].store(d->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			Table::shards[i & Table::SHARD_MASK].allocator.free(d);
 		}
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
+
+	for (Table::Shard &shard : Table::shards) {
+		Table::free_retired(shard);
+		shard.mutex.unlock();
+	}
 	configured = false;
 }
 
@@ -110,22 +211,32 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		const uint32_t idx = _data->hash & Table::TABLE_MASK;
+		Table::Shard &shard = Table::shards[idx & Table::SHARD_MASK];
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
 		}
+		_Data *next = _data->next.load(std::memory_order_relaxed);
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next, std::memory_order_release);
 		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
+			Table::table[idx].store(next, std::memory_order_release);
+		}
+
+		if (next) {
+			next->prev = _data->prev;
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		// Lookups that got to this entry before it was unlinked may still be on it.
+		// The ones starting from now on can't reach it, so it can be freed once
+		// no lookup is running on this shard.
+		shard.retired.push_back(_data);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (shard.readers.load(std::memory_order_acquire) == 0) {
+			Table::free_retired(shard);
 		}
-		Table::allocator.free(_data);
 	}
 
 	_data = nullptr;
@@ -210,52 +321,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name, String::hash(p_name), p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -267,51 +333,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name, p_name.hash(), p_static);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -49,8 +49,8 @@ class [[nodiscard]] StringName {
 #endif
 
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		_Data *prev = nullptr; // Only used with the table lock held.
+		std::atomic<_Data *> next = nullptr; // Also followed by lookups without the lock.
 	};
 
 	_Data *_data = nullptr;
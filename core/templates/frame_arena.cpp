@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/error/error_macros.h"
+
+std::atomic<uint64_t> FrameArena::global_frame = 0;
+thread_local FrameArena FrameArena::thread_arena;
+
+FrameArena &FrameArena::_get_thread_arena() {
+	FrameArena &arena = thread_arena;
+	arena._set_frame(global_frame.load(std::memory_order_acquire));
+	return arena;
+}
+
+void FrameArena::release_memory() {
+	for (uint32_t i = 0; i < 2; i++) {
+		_recycle_generation(i);
+	}
+	while (free_blocks) {
+		Block *next = free_blocks->next;
+		memfree(free_blocks);
+		free_blocks = next;
+	}
+	free_block_count = 0;
+	last_allocation = nullptr;
+}
+
+void FrameArena::_recycle_generation(uint32_t p_generation) {
+	Block *block = generations[p_generation];
+	while (block) {
+		Block *next = block->next;
+		if (block->size == BLOCK_SIZE && free_block_count < MAX_FREE_BLOCKS) {
+			block->used = 0;
+			block->next = free_blocks;
+			free_blocks = block;
+			free_block_count++;
+		} else {
+			// Oversized blocks and blocks beyond the cache limit go back to the system.
+			memfree(block);
+		}
+		block = next;
+	}
+	generations[p_generation] = nullptr;
+}
+
+void FrameArena::_set_frame(uint64_t p_frame) {
+	if (likely(frame == p_frame)) {
+		return;
+	}
+	if (p_frame - frame >= 2) {
+		// Both generations are at least two frames old.
+		_recycle_generation(0);
+		_recycle_generation(1);
+	} else {
+		// The slot of the new frame holds the allocations from two frames ago.
+		_recycle_generation(p_frame & 1);
+	}
+	frame = p_frame;
+	last_allocation = nullptr;
+}
+
+FrameArena::Block *FrameArena::_acquire_block(size_t p_min_size) {
+	if (p_min_size <= BLOCK_SIZE && free_blocks) {
+		Block *block = free_blocks;
+		free_blocks = block->next;
+		free_block_count--;
+		block->next = nullptr;
+		return block;
+	}
+
+	size_t size = MAX(p_min_size, BLOCK_SIZE);
+	Block *block = (Block *)memalloc(BLOCK_HEADER_SIZE + size);
+	CRASH_COND_MSG(!block, "Out of memory");
+	block->next = nullptr;
+	block->size = size;
+	block->used = 0;
+	return block;
+}
+
+void *FrameArena::allocate(size_t p_size) {
+	size_t size = _align(MAX(p_size, (size_t)1));
+	Block *&head = generations[frame & 1];
+	if (unlikely(!head || head->used + size > head->size)) {
+		Block *block = _acquire_block(size);
+		block->next = head;
+		head = block;
+	}
+
+	uint8_t *ptr = _get_block_data(head) + head->used;
+	head->used += size;
+	last_allocation = ptr;
+	return ptr;
+}
+
+void *FrameArena::reallocate(void *p_ptr, size_t p_old_size, size_t p_new_size) {
+	if (!p_ptr) {
+		return allocate(p_new_size);
+	}
+
+	if (p_ptr == last_allocation) {
+		Block *head = generations[frame & 1];
+		size_t offset = (uint8_t *)p_ptr - _get_block_data(head);
+		size_t new_size = _align(MAX(p_new_size, (size_t)1));
+		if (offset + new_size <= head->size) {
+			head->used = offset + new_size;
+			return p_ptr;
+		}
+	}
+
+	void *new_ptr = allocate(p_new_size);
+	memcpy(new_ptr, p_ptr, MIN(p_old_size, p_new_size));
+	return new_ptr;
+}
+
+size_t FrameArena::get_usage() const {
+	size_t usage = 0;
+	for (Block *block = generations[frame & 1]; block; block = block->next) {
+		usage += block->used;
+	}
+	return usage;
+}
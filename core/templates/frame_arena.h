@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Bump allocator for temporaries that don't outlive the frame.
+//
+// Allocations are never freed individually. An arena keeps two generations of
+// blocks; the generation of the previous frame is recycled when the arena moves
+// to a new frame, so memory handed out during frame N stays valid until the end
+// of frame N + 1.
+//
+// An instance is owned by a single thread and advanced with advance_frame().
+// The static functions use a per-thread arena instead, which follows the frame
+// counter advanced once per iteration by Main::iteration(); it catches up
+// lazily on the first allocation of the thread in a new frame, so no
+// cross-thread reset is needed.
+//
+// FrameArena can be plugged as the allocator of LocalVector, List and RBMap,
+// and FrameArenaTypedAllocator can be used for HashMap elements. Don't keep
+// such containers around across frames (e.g. as class members), and don't use
+// them in tasks that can run for longer than a frame.
+class FrameArena {
+public:
+	static constexpr size_t ALIGNMENT = 16;
+	static constexpr size_t BLOCK_SIZE = 256 * 1024;
+	static constexpr uint32_t MAX_FREE_BLOCKS = 8;
+
+private:
+	struct Block {
+		Block *next = nullptr;
+		size_t size = 0; // Usable bytes, excluding the header.
+		size_t used = 0;
+	};
+
+	static constexpr size_t BLOCK_HEADER_SIZE = (sizeof(Block) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	Block *generations[2] = {}; // Block in use is the head of each list.
+	Block *free_blocks = nullptr;
+	uint32_t free_block_count = 0;
+	uint64_t frame = 0;
+	uint8_t *last_allocation = nullptr;
+
+	static std::atomic<uint64_t> global_frame;
+	static thread_local FrameArena thread_arena;
+
+	_FORCE_INLINE_ static uint8_t *_get_block_data(Block *p_block) { return (uint8_t *)p_block + BLOCK_HEADER_SIZE; }
+	_FORCE_INLINE_ static size_t _align(size_t p_size) { return (p_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+	void _set_frame(uint64_t p_frame);
+	void _recycle_generation(uint32_t p_generation);
+	Block *_acquire_block(size_t p_min_size);
+	static FrameArena &_get_thread_arena();
+
+public:
+	void *allocate(size_t p_size);
+	// Grows or shrinks in place if p_ptr is the latest allocation, copies otherwise.
+	void *reallocate(void *p_ptr, size_t p_old_size, size_t p_new_size);
+	void advance_frame() { _set_frame(frame + 1); }
+
+	// Bytes handed out in the current frame.
+	size_t get_usage() const;
+	// Releases every block. All allocations become invalid.
+	void release_memory();
+
+	// Allocator interface, using the arena of the calling thread.
+	static void *alloc(size_t p_size) { return _get_thread_arena().allocate(p_size); }
+	static void *realloc(void *p_ptr, size_t p_old_size, size_t p_new_size) { return _get_thread_arena().reallocate(p_ptr, p_old_size, p_new_size); }
+	_FORCE_INLINE_ static void free(void *p_ptr) {}
+
+	static void next_frame() { global_frame.fetch_add(1, std::memory_order_release); }
+	static uint64_t get_frame() { return global_frame.load(std::memory_order_acquire); }
+
+	// Bytes handed out by the calling thread in the current frame.
+	static size_t get_thread_usage() { return _get_thread_arena().get_usage(); }
+	// Releases every block owned by the calling thread. All of its allocations become invalid.
+	static void free_thread_memory() { thread_arena.release_memory(); }
+
+	FrameArena() = default;
+	FrameArena(const FrameArena &) = delete;
+	FrameArena &operator=(const FrameArena &) = delete;
+	~FrameArena() { release_memory(); }
+};
+
+// Element allocator for HashMap (and other users of DefaultTypedAllocator).
+template <typename T>
+class FrameArenaTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameArena::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			p_allocation->~T();
+		}
+	}
+};
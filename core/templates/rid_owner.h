@@ -94,6 +94,18 @@ protected:
 		return base_id.increment();
 	}
 
+	// Reserves p_count consecutive IDs and returns the first one.
+	static uint64_t _gen_id_block(uint32_t p_count) {
+		return base_id.add(p_count) - p_count + 1;
+	}
+
+	// Spreads threads evenly over the shards of sharded allocators.
+	static uint32_t _get_thread_shard() {
+		static SafeNumeric<uint32_t> thread_count;
+		static thread_local uint32_t shard = thread_count.postincrement();
+		return shard;
+	}
+
 public:
 	virtual ~RID_AllocBase() {}
 };
@@ -491,9 +503,296 @@ public:
 	}
 };
 
-template <typename T, bool THREAD_SAFE = false>
+// Thread-safe allocator for RIDs that are made and freed from many threads at once.
+// Lookups take no lock: chunks never move once allocated and each element carries
+// an atomic validator. Free indices are kept in shards that threads are spread over,
+// so allocating and freeing only contend when threads share a shard or a shard runs
+// dry and has to take indices from another one or grow a new chunk.
+template <typename T>
+class RID_ShardedAlloc : public RID_AllocBase {
+	static constexpr uint32_t SHARD_COUNT = 16;
+	static constexpr uint32_t ID_BLOCK_SIZE = 64;
+
+	struct Chunk {
+		T data;
+		std::atomic<uint32_t> validator;
+	};
+
+	struct Shard {
+		BinaryMutex mutex;
+		LocalVector<uint32_t> free_list;
+		uint64_t next_id = 0;
+		uint32_t ids_left = 0;
+	};
+
+	Chunk **chunks = nullptr;
+	Shard shards[SHARD_COUNT];
+
+	uint32_t elements_in_chunk;
+	std::atomic<uint32_t> max_alloc = 0;
+	std::atomic<uint32_t> alloc_count = 0;
+	uint32_t chunk_limit = 0;
+
+	const char *description = nullptr;
+
+	BinaryMutex grow_mutex;
+
+	_FORCE_INLINE_ Chunk &_get_chunk(uint32_t p_index) const {
+		return chunks[p_index / elements_in_chunk][p_index % elements_in_chunk];
+	}
+
+	// Called with the shard locked. Takes half of the free indices of another shard or,
+	// if all are empty, grows a new chunk whose indices all go to this shard.
+	bool _refill_shard(Shard &p_shard) {
+		for (uint32_t i = 1; i < SHARD_COUNT; i++) {
+			Shard &victim = shards[(uint32_t(&p_shard - shards) + i) % SHARD_COUNT];
+			if (victim.free_list.is_empty() || !victim.mutex.try_lock()) {
+				continue; // Don't wait, two shards refilling from each other would deadlock.
+			}
+			uint32_t count = victim.free_list.size();
+			uint32_t take = MAX(count / 2, 1u);
+			for (uint32_t j = count - take; j < count; j++) {
+				p_shard.free_list.push_back(victim.free_list[j]);
+			}
+			victim.free_list.resize(count - take);
+			victim.mutex.unlock();
+			return true;
+		}
+
+		MutexLock lock(grow_mutex);
+		uint32_t ma = max_alloc.load(std::memory_order_relaxed);
+		uint32_t chunk_count = ma / elements_in_chunk;
+		if (chunk_count == chunk_limit) {
+			return false;
+		}
+
+		Chunk *chunk = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); // But don't initialize data.
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			memnew_placement(&chunk[i].validator, std::atomic<uint32_t>(0xFFFFFFFF));
+		}
+		// Pushed in reverse so the lowest indices are handed out first.
+		for (uint32_t i = elements_in_chunk; i > 0; i--) {
+			p_shard.free_list.push_back(ma + i - 1);
+		}
+		chunks[chunk_count] = chunk;
+		// Publishes the chunk to get_or_null(), which checks the index against this first.
+		max_alloc.store(ma + elements_in_chunk, std::memory_order_release);
+		return true;
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
+		Shard &shard = shards[_get_thread_shard() % SHARD_COUNT];
+		shard.mutex.lock();
+
+		if (shard.free_list.is_empty() && !_refill_shard(shard)) {
+			shard.mutex.unlock();
+			if (description != nullptr) {
+				ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
+			} else {
+				ERR_FAIL_V_MSG(RID(), "Element limit reached.");
+			}
+		}
+
+		uint32_t free_index = shard.free_list[shard.free_list.size() - 1];
+		shard.free_list.resize(shard.free_list.size() - 1);
+
+		// IDs are reserved in blocks, so they stay unique across allocators without
+		// every allocation touching the shared counter.
+		if (shard.ids_left == 0) {
+			shard.next_id = _gen_id_block(ID_BLOCK_SIZE);
+			shard.ids_left = ID_BLOCK_SIZE;
+		}
+		uint64_t gen_id = shard.next_id++;
+		shard.ids_left--;
+
+		shard.mutex.unlock();
+
+		uint32_t validator = 1 + (uint32_t)(gen_id % 0x7FFFFFFF);
+		uint64_t id = validator;
+		id <<= 32;
+		id |= free_index;
+
+		_get_chunk(free_index).validator.store(validator | 0x80000000, std::memory_order_release); // Mark uninitialized bit.
+		alloc_count.fetch_add(1, std::memory_order_relaxed);
+
+		return _make_from_id(id);
+	}
+
+public:
+	RID make_rid() {
+		RID rid = _allocate_rid();
+		initialize_rid(rid);
+		return rid;
+	}
+	RID make_rid(const T &p_value) {
+		RID rid = _allocate_rid();
+		initialize_rid(rid, p_value);
+		return rid;
+	}
+
+	//allocate but don't initialize, use initialize_rid afterwards
+	RID allocate_rid() {
+		return _allocate_rid();
+	}
+
+	_FORCE_INLINE_ T *get_or_null(const RID &p_rid, bool p_initialize = false) {
+		if (p_rid == RID()) {
+			return nullptr;
+		}
+
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
+			return nullptr;
+		}
+
+		uint32_t validator = uint32_t(id >> 32);
+
+		Chunk &c = _get_chunk(idx);
+		uint32_t current = c.validator.load(std::memory_order_acquire);
+
+		if (unlikely(p_initialize)) {
+			if (unlikely(!(current & 0x80000000))) {
+				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
+			}
+
+			if (unlikely((current & 0x7FFFFFFF) != validator)) {
+				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
+			}
+
+			c.validator.store(validator, std::memory_order_relaxed); //initialized
+
+		} else if (unlikely(current != validator)) {
+			if ((current & 0x80000000) && current != 0xFFFFFFFF) {
+				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
+			}
+			return nullptr;
+		}
+
+		return &c.data;
+	}
+	void initialize_rid(RID p_rid) {
+		T *mem = get_or_null(p_rid, true);
+		ERR_FAIL_NULL(mem);
+		memnew_placement(mem, T);
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+	void initialize_rid(RID p_rid, const T &p_value) {
+		T *mem = get_or_null(p_rid, true);
+		ERR_FAIL_NULL(mem);
+		memnew_placement(mem, T(p_value));
+		std::atomic_thread_fence(std::memory_order_release);
+	}
+
+	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
+		if (p_rid == RID()) {
+			return false;
+		}
+
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		if (unlikely(idx >= max_alloc.load(std::memory_order_acquire))) {
+			return false;
+		}
+
+		uint32_t validator = uint32_t(id >> 32);
+		return (_get_chunk(idx).validator.load(std::memory_order_acquire) & 0x7FFFFFFF) == validator;
+	}
+
+	_FORCE_INLINE_ void free(const RID &p_rid) {
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		ERR_FAIL_COND(idx >= max_alloc.load(std::memory_order_acquire));
+
+		uint32_t validator = uint32_t(id >> 32);
+		Chunk &c = _get_chunk(idx);
+		uint32_t current = c.validator.load(std::memory_order_acquire);
+		ERR_FAIL_COND_MSG(current & 0x80000000, "Attempted to free an uninitialized or invalid RID");
+		ERR_FAIL_COND(current != validator);
+
+		// Claim the element first, so a concurrent free of the same RID fails instead of destroying it twice.
+		ERR_FAIL_COND(!c.validator.compare_exchange_strong(current, 0xFFFFFFFF, std::memory_order_acq_rel)); // Go invalid.
+
+		c.data.~T();
+		alloc_count.fetch_sub(1, std::memory_order_relaxed);
+
+		Shard &shard = shards[_get_thread_shard() % SHARD_COUNT];
+		MutexLock lock(shard.mutex);
+		shard.free_list.push_back(idx);
+	}
+
+	_FORCE_INLINE_ uint32_t get_rid_count() const {
+		return alloc_count.load(std::memory_order_relaxed);
+	}
+	LocalVector<RID> get_owned_list() const {
+		LocalVector<RID> owned;
+		uint32_t ma = max_alloc.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < ma; i++) {
+			uint64_t validator = _get_chunk(i).validator.load(std::memory_order_acquire);
+			if (validator != 0xFFFFFFFF) {
+				owned.push_back(_make_from_id((validator << 32) | i));
+			}
+		}
+		return owned;
+	}
+
+	//used for fast iteration in the elements or RIDs
+	//the buffer must have room for get_rid_count() RIDs, so RIDs must not be made meanwhile
+	void fill_owned_buffer(RID *p_rid_buffer) const {
+		uint32_t idx = 0;
+		uint32_t ma = max_alloc.load(std::memory_order_acquire);
+		for (uint32_t i = 0; i < ma; i++) {
+			uint64_t validator = _get_chunk(i).validator.load(std::memory_order_acquire);
+			if (validator != 0xFFFFFFFF) {
+				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
+				idx++;
+			}
+		}
+	}
+
+	void set_description(const char *p_description) {
+		description = p_description;
+	}
+
+	RID_ShardedAlloc(uint32_t p_target_chunk_byte_size = 65536, uint32_t p_maximum_number_of_elements = 262144) {
+		elements_in_chunk = sizeof(Chunk) > p_target_chunk_byte_size ? 1 : (p_target_chunk_byte_size / sizeof(Chunk));
+		chunk_limit = (p_maximum_number_of_elements / elements_in_chunk) + 1;
+		chunks = (Chunk **)memalloc(sizeof(Chunk *) * chunk_limit);
+	}
+
+	~RID_ShardedAlloc() {
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		uint32_t ma = max_alloc.load(std::memory_order_relaxed);
+		uint32_t count = alloc_count.load(std::memory_order_relaxed);
+		if (count) {
+			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
+					count, description ? description : typeid(T).name()));
+
+			for (uint32_t i = 0; i < ma; i++) {
+				uint32_t validator = _get_chunk(i).validator.load(std::memory_order_relaxed);
+				if (validator & 0x80000000) {
+					continue; //uninitialized
+				}
+				_get_chunk(i).data.~T();
+			}
+		}
+
+		uint32_t chunk_count = ma / elements_in_chunk;
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			memfree(chunks[i]);
+		}
+		memfree(chunks);
+	}
+};
+
+// With SHARDED, RIDs can be made, freed and looked up from many threads with little contention.
+// See RID_ShardedAlloc.
+template <typename T, bool THREAD_SAFE = false, bool SHARDED = false>
 class RID_PtrOwner {
-	RID_Alloc<T *, THREAD_SAFE> alloc;
+	static_assert(!SHARDED || THREAD_SAFE, "Sharded RID owners are always thread-safe.");
+	std::conditional_t<SHARDED, RID_ShardedAlloc<T *>, RID_Alloc<T *, THREAD_SAFE>> alloc;
 
 public:
 	_FORCE_INLINE_ RID make_rid(T *p_ptr) {
@@ -550,9 +849,12 @@ public:
 			alloc(p_target_chunk_byte_size, p_maximum_number_of_elements) {}
 };
 
-template <typename T, bool THREAD_SAFE = false>
+// With SHARDED, RIDs can be made, freed and looked up from many threads with little contention.
+// See RID_ShardedAlloc.
+template <typename T, bool THREAD_SAFE = false, bool SHARDED = false>
 class RID_Owner {
-	RID_Alloc<T, THREAD_SAFE> alloc;
+	static_assert(!SHARDED || THREAD_SAFE, "Sharded RID owners are always thread-safe.");
+	std::conditional_t<SHARDED, RID_ShardedAlloc<T>, RID_Alloc<T, THREAD_SAFE>> alloc;
 
 public:
 	_FORCE_INLINE_ RID make_rid() {
@@ -34,6 +34,15 @@
 
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
 	const uint64_t buffer_size = f->get_length();
+	f->set_access_pattern(FileAccess::ACCESS_PATTERN_SEQUENTIAL);
+	const uint8_t *mapped = f->get_mapped_buffer();
+	if (mapped) {
+		// Decode straight from the mapping, starting where the caller left the file (e.g. after a header).
+		const uint64_t position = f->get_position();
+		ERR_FAIL_COND_V(position > buffer_size, ERR_FILE_CORRUPT);
+		return PNGDriverCommon::png_to_image(mapped + position, buffer_size - position, p_flags & FLAG_FORCE_LINEAR, p_image);
+	}
+
 	Vector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
 	if (err) {
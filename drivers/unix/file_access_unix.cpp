@@ -36,6 +36,7 @@
 #include "core/string/print_string.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #if !defined(__FreeBSD__) && !defined(__OpenBSD__) && !defined(__NetBSD__) && !defined(WEB_ENABLED)
@@ -204,6 +205,15 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap(mapped, mapped_length);
+		mapped = nullptr;
+		mapped_length = 0;
+		mapped_position = 0;
+		mapped_eof = false;
+	}
+	access_pattern = ACCESS_PATTERN_NORMAL;
+
 	fclose(f);
 	f = nullptr;
 
@@ -258,6 +268,13 @@ String FileAccessUnix::get_real_path() const {
 void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped) {
+		mapped_position = p_position;
+		mapped_eof = false;
+		last_error = OK;
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -266,6 +283,12 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped) {
+		ERR_FAIL_COND(p_position < 0 && (uint64_t)-p_position > mapped_length);
+		seek(mapped_length + p_position);
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -274,6 +297,10 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped) {
+		return mapped_position;
+	}
+
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -285,6 +312,10 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped) {
+		return mapped_length;
+	}
+
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -296,6 +327,9 @@ uint64_t FileAccessUnix::get_length() const {
 }
 
 bool FileAccessUnix::eof_reached() const {
+	if (mapped) {
+		return mapped_eof;
+	}
 	return feof(f);
 }
 
@@ -303,12 +337,85 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
+	if (mapped) {
+		// Copied straight from the page cache, without the stdio buffer in between.
+		uint64_t available = mapped_position < mapped_length ? mapped_length - mapped_position : 0;
+		uint64_t read = MIN(p_length, available);
+		memcpy(p_dst, mapped + mapped_position, read);
+		mapped_position += read;
+		if (read < p_length) {
+			mapped_eof = true;
+			last_error = ERR_FILE_EOF;
+		}
+		return read;
+	}
+
 	uint64_t read = fread(p_dst, 1, p_length, f);
 	check_errors();
 
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_buffer() {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	if (mapped) {
+		return mapped;
+	}
+	if (flags != READ) {
+		return nullptr; // Writes would not be reflected in a private mapping.
+	}
+
+	uint64_t position = get_position();
+	uint64_t length = get_length();
+	if (length == 0) {
+		return nullptr;
+	}
+
+	// Note that truncating the file while it's mapped makes accesses past the new end fault.
+	void *ptr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped = (uint8_t *)ptr;
+	mapped_length = length;
+	mapped_position = position;
+	mapped_eof = feof(f);
+	_apply_access_pattern();
+	return mapped;
+}
+
+void FileAccessUnix::set_access_pattern(AccessPattern p_pattern) {
+	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
+
+	access_pattern = p_pattern;
+	_apply_access_pattern();
+}
+
+void FileAccessUnix::_apply_access_pattern() {
+	if (mapped) {
+		int advice = MADV_NORMAL;
+		if (access_pattern == ACCESS_PATTERN_SEQUENTIAL) {
+			advice = MADV_SEQUENTIAL;
+		} else if (access_pattern == ACCESS_PATTERN_RANDOM) {
+			advice = MADV_RANDOM;
+		}
+		madvise(mapped, mapped_length, advice);
+		return;
+	}
+
+#ifdef POSIX_FADV_NORMAL
+	int advice = POSIX_FADV_NORMAL;
+	if (access_pattern == ACCESS_PATTERN_SEQUENTIAL) {
+		advice = POSIX_FADV_SEQUENTIAL;
+	} else if (access_pattern == ACCESS_PATTERN_RANDOM) {
+		advice = POSIX_FADV_RANDOM;
+	}
+	posix_fadvise(fileno(f), 0, 0, advice);
+#endif
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
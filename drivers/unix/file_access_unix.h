@@ -47,6 +47,16 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Lazily created by get_mapped_buffer(), unmapped on close. Once mapped,
+	// reads are served from the mapping instead of going through stdio.
+	uint8_t *mapped = nullptr;
+	uint64_t mapped_length = 0;
+	mutable uint64_t mapped_position = 0;
+	mutable bool mapped_eof = false;
+	AccessPattern access_pattern = ACCESS_PATTERN_NORMAL;
+
+	void _apply_access_pattern();
+
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -71,6 +81,8 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer() override;
+	virtual void set_access_pattern(AccessPattern p_pattern) override;
 
 	virtual Error get_error() const override; ///< get last error
 
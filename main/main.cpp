@@ -41,6 +41,7 @@
 #include "core/input/input.h"
 #include "core/input/input_map.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/file_access_zip.h"
 #include "core/io/image.h"
 #include "core/io/image_loader.h"
@@ -53,6 +54,7 @@
 #include "core/profiling/profiling.h"
 #include "core/register_core_types.h"
 #include "core/string/translation_server.h"
+#include "core/templates/frame_arena.h"
 #include "core/version.h"
 #include "drivers/register_driver_types.h"
 #include "main/app_icon.gen.h"
@@ -156,6 +158,7 @@ static Input *input = nullptr;
 static InputMap *input_map = nullptr;
 static TranslationServer *translation_server = nullptr;
 static Performance *performance = nullptr;
+static PackedData *packed_data = nullptr;
 #ifdef MINIZIP_ENABLED
 static ZipArchive *zip_packed_data = nullptr;
 #endif
@@ -1077,6 +1080,11 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	String default_renderer_mobile = "";
 	String renderer_hints = "";
 
+	packed_data = PackedData::get_singleton();
+	if (!packed_data) {
+		packed_data = memnew(PackedData);
+	}
+
 #ifdef MINIZIP_ENABLED
 
 	//XXX: always get_singleton() == 0x0
@@ -1086,6 +1094,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		zip_packed_data = memnew(ZipArchive);
 	}
 
+	packed_data->add_pack_source(zip_packed_data);
+
 #endif
 
 	// Exit error code used in the `goto error` conditions.
@@ -2048,7 +2058,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		} else {
 			int worker_threads = GLOBAL_GET("threading/worker_pool/max_threads");
 			float low_priority_ratio = GLOBAL_GET("threading/worker_pool/low_priority_thread_ratio");
-			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio);
+			WorkerThreadPool::Scheduler scheduler = GLOBAL_GET("threading/worker_pool/work_stealing") ? WorkerThreadPool::SCHEDULER_WORK_STEALING : WorkerThreadPool::SCHEDULER_SHARED_QUEUE;
+			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio, scheduler);
 		}
 #else
 		WorkerThreadPool::get_singleton()->init(0, 0);
@@ -2865,6 +2876,9 @@ error:
 	if (globals) {
 		memdelete(globals);
 	}
+	if (packed_data) {
+		memdelete(packed_data);
+	}
 
 	unregister_core_driver_types();
 	unregister_core_extensions();
@@ -4952,6 +4966,9 @@ bool Main::iteration() {
 
 	iterating--;
 
+	// Temporaries allocated during this iteration stay valid until the end of the next one.
+	FrameArena::next_frame();
+
 	if (movie_writer) {
 		GodotProfileZoneGrouped(_profile_zone, "movie_writer->add_frame");
 		movie_writer->add_frame();
@@ -5167,6 +5184,9 @@ void Main::cleanup(bool p_force) {
 	if (globals) {
 		memdelete(globals);
 	}
+	if (packed_data) {
+		memdelete(packed_data);
+	}
 
 	if (OS::get_singleton()->is_restart_on_exit_set()) {
 		//attempt to restart with arguments
@@ -5193,6 +5213,7 @@ void Main::cleanup(bool p_force) {
 		memdelete(engine);
 	}
 
+	FrameArena::free_thread_memory();
 	unregister_core_types();
 
 	OS::get_singleton()->benchmark_end_measure("Shutdown", "Main::Cleanup");
@@ -816,7 +816,7 @@ Error GDScript::reload(bool p_keep_state) {
 	if (!binary_tokens.is_empty()) {
 		err = parser.parse_binary(binary_tokens, path);
 	} else {
-		err = parser.parse(source, path, false);
+		err = GDScriptCache::parse_source_code(&parser, source, path);
 	}
 	if (err) {
 		if (EngineDebugger::is_active()) {
@@ -2962,6 +2962,7 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	GLOBAL_DEF("debug/settings/gdscript/cache_tokens", false);
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
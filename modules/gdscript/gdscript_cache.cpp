@@ -34,9 +34,19 @@
 #include "gdscript_analyzer.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
+#include "gdscript_tokenizer_buffer.h"
 
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
+#include "core/version.h"
+
+// Bump when the layout of the token cache files changes.
+static const uint32_t TOKEN_CACHE_FORMAT_VERSION = 2;
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
 	return status;
@@ -83,7 +93,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				} else {
 					String source = GDScriptCache::get_source_code(remapped_path);
 					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
+					result = GDScriptCache::parse_source_code(get_parser(), source, path);
 				}
 			} break;
 			case PARSED: {
@@ -295,6 +305,163 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	return buffer;
 }
 
+String GDScriptCache::_get_token_cache_dir() {
+	MutexLock lock(singleton->token_cache_mutex);
+
+	if (!singleton->token_cache_initialized) {
+		singleton->token_cache_initialized = true;
+
+		// The editor parses sources for documentation and completion, which needs comments and columns.
+		if (GLOBAL_GET("debug/settings/gdscript/cache_tokens") && !Engine::get_singleton()->is_editor_hint()) {
+			Ref<DirAccess> da = DirAccess::open("user://");
+			if (da.is_valid() && (da->dir_exists("gdscript_cache") || da->make_dir("gdscript_cache") == OK)) {
+				singleton->token_cache_dir = "user://gdscript_cache";
+				prune_token_cache(singleton->token_cache_dir);
+			}
+		}
+	}
+
+	return singleton->token_cache_dir;
+}
+
+static String _get_token_cache_engine_version() {
+	return String(GODOT_VERSION_FULL_BUILD) + "." + GODOT_VERSION_HASH;
+}
+
+// Reads the header of a cache entry, leaving the file positioned at the token payload size.
+static bool _read_token_cache_header(const Ref<FileAccess> &p_file, String &r_script_path, uint64_t &r_source_hash, uint32_t &r_source_length) {
+	uint8_t magic[4] = {};
+	p_file->get_buffer(magic, 4);
+	if (magic[0] != 'G' || magic[1] != 'D' || magic[2] != 'T' || magic[3] != 'C') {
+		return false;
+	}
+	if (p_file->get_32() != TOKEN_CACHE_FORMAT_VERSION || p_file->get_32() != GDScriptTokenizerBuffer::TOKENIZER_VERSION) {
+		return false;
+	}
+	if (p_file->get_pascal_string() != _get_token_cache_engine_version()) {
+		return false;
+	}
+	r_script_path = p_file->get_pascal_string();
+	r_source_hash = p_file->get_64();
+	r_source_length = p_file->get_32();
+	return !p_file->eof_reached();
+}
+
+void GDScriptCache::prune_token_cache(const String &p_cache_dir) {
+	Ref<DirAccess> da = DirAccess::open(p_cache_dir);
+	if (da.is_null()) {
+		return;
+	}
+
+	LocalVector<String> stale;
+	da->list_dir_begin();
+	for (String name = da->get_next(); !name.is_empty(); name = da->get_next()) {
+		if (da->current_is_dir()) {
+			continue;
+		}
+		if (name.ends_with(".tmp")) {
+			stale.push_back(name); // Left behind by a run that didn't finish writing.
+			continue;
+		}
+		if (name.get_extension() != "gdt") {
+			continue;
+		}
+
+		// Entries from other engine or format versions, and of scripts that are gone, are never read again.
+		String script_path;
+		uint64_t source_hash = 0;
+		uint32_t source_length = 0;
+		Ref<FileAccess> f = FileAccess::open(p_cache_dir.path_join(name), FileAccess::READ);
+		if (f.is_null() || !_read_token_cache_header(f, script_path, source_hash, source_length) || !FileAccess::exists(script_path)) {
+			stale.push_back(name);
+		}
+	}
+	da->list_dir_end();
+
+	for (const String &name : stale) {
+		da->remove(name);
+	}
+}
+
+Vector<uint8_t> GDScriptCache::get_cached_binary_tokens(const String &p_path, const String &p_source) {
+	const String cache_dir = _get_token_cache_dir();
+	if (cache_dir.is_empty()) {
+		return Vector<uint8_t>();
+	}
+
+	return get_cached_binary_tokens(p_path, p_source, cache_dir);
+}
+
+Vector<uint8_t> GDScriptCache::get_cached_binary_tokens(const String &p_path, const String &p_source, const String &p_cache_dir) {
+	if (!p_path.is_resource_file()) {
+		return Vector<uint8_t>(); // Built-in scripts are stored with their owner.
+	}
+
+	const String cache_path = p_cache_dir.path_join(p_path.md5_text() + ".gdt");
+	const uint64_t source_hash = p_source.hash64();
+
+	Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::READ);
+	if (f.is_valid()) {
+		String script_path;
+		uint64_t cached_hash = 0;
+		uint32_t cached_length = 0;
+		if (_read_token_cache_header(f, script_path, cached_hash, cached_length) &&
+				script_path == p_path && cached_hash == source_hash && cached_length == (uint32_t)p_source.length()) {
+			uint32_t size = f->get_32();
+			Vector<uint8_t> tokens;
+			tokens.resize(size);
+			if (size > 0 && f->get_buffer(tokens.ptrw(), size) == size) {
+				return tokens;
+			}
+		}
+	}
+
+	// Missing or stale, tokenize now and keep the result for the next run.
+	Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(p_source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	if (tokens.is_empty()) {
+		return tokens;
+	}
+
+	// Written aside and renamed, so concurrent loads never see a partial file.
+	const String temp_path = cache_path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	f = FileAccess::open(temp_path, FileAccess::WRITE);
+	if (f.is_valid()) {
+		f->store_buffer((const uint8_t *)"GDTC", 4);
+		f->store_32(TOKEN_CACHE_FORMAT_VERSION);
+		f->store_32(GDScriptTokenizerBuffer::TOKENIZER_VERSION);
+		f->store_pascal_string(_get_token_cache_engine_version());
+		f->store_pascal_string(p_path);
+		f->store_64(source_hash);
+		f->store_32(p_source.length());
+		f->store_32(tokens.size());
+		f->store_buffer(tokens.ptr(), tokens.size());
+		bool stored = f->get_error() == OK;
+		f.unref();
+
+		Ref<DirAccess> da = DirAccess::open(p_cache_dir);
+		if (da.is_valid()) {
+			if (!stored || da->rename(temp_path, cache_path) != OK) {
+				da->remove(temp_path);
+			}
+		}
+	}
+
+	return tokens;
+}
+
+Error GDScriptCache::parse_source_code(GDScriptParser *p_parser, const String &p_source, const String &p_path) {
+	Vector<uint8_t> tokens = get_cached_binary_tokens(p_path, p_source);
+	if (!tokens.is_empty()) {
+		Error err = p_parser->parse_binary(tokens, p_path);
+		if (err == OK) {
+			return OK;
+		}
+		// Binary tokens don't keep columns, so report errors from the source instead.
+	}
+
+	return p_parser->parse(p_source, p_path, false);
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
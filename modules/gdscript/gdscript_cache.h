@@ -33,6 +33,7 @@
 #include "gdscript.h"
 
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/os/safe_binary_mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
@@ -96,6 +97,13 @@ class GDScriptCache {
 
 	bool cleared = false;
 
+	// Binary tokens of text scripts are kept on disk across runs, so unchanged scripts skip the text tokenizer.
+	BinaryMutex token_cache_mutex;
+	String token_cache_dir;
+	bool token_cache_initialized = false;
+
+	static String _get_token_cache_dir();
+
 public:
 	static const int BINARY_MUTEX_TAG = 2;
 
@@ -111,6 +119,10 @@ public:
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
 	static Vector<uint8_t> get_binary_tokens(const String &p_path);
+	static Vector<uint8_t> get_cached_binary_tokens(const String &p_path, const String &p_source);
+	static Vector<uint8_t> get_cached_binary_tokens(const String &p_path, const String &p_source, const String &p_cache_dir);
+	static void prune_token_cache(const String &p_cache_dir);
+	static Error parse_source_code(GDScriptParser *p_parser, const String &p_source, const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
@@ -540,6 +540,17 @@ Error GDScriptParser::parse_binary(const Vector<uint8_t> &p_binary, const String
 		current = tokenizer->scan();
 	}
 
+#ifdef DEBUG_ENABLED
+	// Warn about parsing an empty script file, same as with the source. Tokens cached from text scripts go through here.
+	if (current.type == GDScriptTokenizer::Token::TK_EOF) {
+		Node *nd = alloc_node<PassNode>();
+		nd->start_line = 1;
+		nd->start_column = 0;
+		nd->end_line = 1;
+		push_warning(nd, GDScriptWarning::EMPTY_FILE);
+	}
+#endif // DEBUG_ENABLED
+
 	push_multiline(false); // Keep one for the whole parsing.
 	parse_program();
 	pop_multiline();
@@ -32,7 +32,14 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_cache.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -72,6 +79,64 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Binary tokens are cached on disk") {
+	const String cache_dir = TestUtils::get_temp_path("gdscript_token_cache");
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+
+	const String path = "res://token_cache_test.gd";
+	const String source = "extends RefCounted\n\nfunc get_value():\n\treturn 42\n";
+	const String cache_path = cache_dir.path_join(path.md5_text() + ".gdt");
+
+	const Vector<uint8_t> tokens = GDScriptCache::get_cached_binary_tokens(path, source, cache_dir);
+	CHECK(tokens == GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE));
+	REQUIRE(FileAccess::exists(cache_path));
+
+	// Swap the cached payload for other tokens behind a valid header, they must be what is served.
+	const Vector<uint8_t> other_tokens = GDScriptTokenizerBuffer::parse_code_string("extends Node\n", GDScriptTokenizerBuffer::COMPRESS_NONE);
+	{
+		Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		f->seek(12);
+		CHECK_FALSE(f->get_pascal_string().is_empty()); // Engine version.
+		CHECK(f->get_pascal_string() == path);
+		const uint64_t payload_size_offset = f->get_position() + 12; // Source hash and length.
+		f->seek(0);
+		const Vector<uint8_t> header = f->get_buffer(payload_size_offset);
+		f = FileAccess::open(cache_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(header);
+		f->store_32(other_tokens.size());
+		f->store_buffer(other_tokens);
+	}
+	CHECK(GDScriptCache::get_cached_binary_tokens(path, source, cache_dir) == other_tokens);
+
+	// A bad header forces the entry to be regenerated.
+	{
+		Ref<FileAccess> f = FileAccess::open(cache_path, FileAccess::READ_WRITE);
+		REQUIRE(f.is_valid());
+		f->store_8('X');
+	}
+	CHECK(GDScriptCache::get_cached_binary_tokens(path, source, cache_dir) == tokens);
+	CHECK(GDScriptCache::get_cached_binary_tokens(path, source, cache_dir) == tokens);
+
+	// A different source for the same path must not reuse the stale entry.
+	const String changed_source = source.replace("42", "43");
+	CHECK(GDScriptCache::get_cached_binary_tokens(path, changed_source, cache_dir) == GDScriptTokenizerBuffer::parse_code_string(changed_source, GDScriptTokenizerBuffer::COMPRESS_NONE));
+
+	// Built-in scripts are never cached.
+	CHECK(GDScriptCache::get_cached_binary_tokens(path + "::GDScript_abcde", source, cache_dir).is_empty());
+
+	// The script doesn't exist in the project, so its entry is pruned along with leftover temporary files.
+	Ref<FileAccess> leftover = FileAccess::open(cache_path + ".1.tmp", FileAccess::WRITE);
+	REQUIRE(leftover.is_valid());
+	leftover.unref();
+	GDScriptCache::prune_token_cache(cache_dir);
+	CHECK_FALSE(FileAccess::exists(cache_path));
+	CHECK_FALSE(FileAccess::exists(cache_path + ".1.tmp"));
+
+	DirAccess::remove_absolute(cache_dir);
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,273 @@
+/**************************************************************************/
+/*  file_access_qmod.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_qmod.h"
+
+#include "qmod_store.h"
+
+#include "core/config/mod_security.h"
+
+Error PackSourceQMod::mount(const String &p_archive_path, const String &p_mount_point, bool p_replace_files) {
+	ERR_FAIL_NULL_V(PackedData::get_singleton(), ERR_UNAVAILABLE);
+
+	Ref<QModArchive> archive;
+	archive.instantiate();
+	Error err = archive->open(p_archive_path);
+	if (err != OK) {
+		return err;
+	}
+
+	// The archive already rejects escaping paths, this guards the mount point itself.
+	const String mount_point = p_mount_point.simplify_path();
+	const String mount_prefix = mount_point.ends_with("/") ? mount_point : mount_point + "/";
+	for (int i = 0; i < archive->get_file_count(); i++) {
+		ERR_FAIL_COND_V_MSG(!mount_point.path_join(archive->get_file_path(i)).simplify_path().begins_with(mount_prefix), ERR_FILE_CORRUPT, vformat("QMOD archive entry escapes its mount point: '%s'.", archive->get_file_path(i)));
+	}
+
+	MutexLock lock(mutex);
+	if (archives.has(p_archive_path)) {
+		PackedData::get_singleton()->remove_pack(p_archive_path);
+	}
+	archives[p_archive_path] = archive;
+
+	for (int i = 0; i < archive->get_file_count(); i++) {
+		PackedData::get_singleton()->add_path(p_archive_path, p_mount_point.path_join(archive->get_file_path(i)), archive->get_file_offset(i), archive->get_file_size(i), this, p_replace_files);
+	}
+	return OK;
+}
+
+Error PackSourceQMod::mount_manifest(const String &p_manifest_path, const String &p_mount_point, bool p_replace_files) {
+	ERR_FAIL_NULL_V(PackedData::get_singleton(), ERR_UNAVAILABLE);
+
+	QModManifest manifest;
+	Error err = manifest.load(p_manifest_path);
+	if (err != OK) {
+		return err;
+	}
+
+	HashMap<String, String> blobs;
+	blobs.reserve(manifest.entries.size());
+	for (const QModManifest::Entry &entry : manifest.entries) {
+		blobs[p_mount_point.path_join(entry.path).simplify_path()] = QModStore::get_blob_path(entry.hash);
+	}
+
+	MutexLock lock(mutex);
+	if (manifests.has(p_manifest_path)) {
+		PackedData::get_singleton()->remove_pack(p_manifest_path);
+	}
+	manifests[p_manifest_path] = blobs;
+
+	for (const QModManifest::Entry &entry : manifest.entries) {
+		PackedData::get_singleton()->add_path(p_manifest_path, p_mount_point.path_join(entry.path), 0, entry.size, this, p_replace_files);
+	}
+	return OK;
+}
+
+void PackSourceQMod::unmount(const String &p_path) {
+	MutexLock lock(mutex);
+	if (!archives.erase(p_path) && !manifests.erase(p_path)) {
+		return;
+	}
+	if (PackedData::get_singleton()) {
+		PackedData::get_singleton()->remove_pack(p_path);
+	}
+}
+
+bool PackSourceQMod::is_mounted(const String &p_path) {
+	MutexLock lock(mutex);
+	return archives.has(p_path) || manifests.has(p_path);
+}
+
+bool PackSourceQMod::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	if (p_offset != 0 || p_path.get_extension().to_lower() != "qmod") {
+		return false;
+	}
+	return mount(p_path, "res://", p_replace_files) == OK;
+}
+
+Ref<FileAccess> PackSourceQMod::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	Ref<QModArchive> archive;
+	String blob_path;
+	{
+		MutexLock lock(mutex);
+		HashMap<String, Ref<QModArchive>>::Iterator E = archives.find(p_file->pack);
+		if (E) {
+			archive = E->value;
+		} else {
+			HashMap<String, HashMap<String, String>>::Iterator M = manifests.find(p_file->pack);
+			if (!M) {
+				return Ref<FileAccess>();
+			}
+			HashMap<String, String>::Iterator B = M->value.find(p_path.simplify_path());
+			if (!B) {
+				return Ref<FileAccess>();
+			}
+			blob_path = B->value;
+		}
+	}
+
+	if (archive.is_null()) {
+		// The virtual path was already checked against the caller's sandbox. The
+		// store itself is shared between mods and stays off limits to them.
+		ModSecurity::Scope unsandboxed((Ref<ModSandbox>()));
+		return FileAccess::open(blob_path, FileAccess::READ);
+	}
+
+	Ref<FileAccessQMod> fa;
+	fa.instantiate();
+	int compressed_index = archive->find_compressed_file(p_file->offset);
+	Error err = compressed_index >= 0 ? fa->open_compressed(archive, compressed_index, p_path) : fa->open_range(archive, p_file->offset, p_file->size, p_path);
+	if (err != OK) {
+		return Ref<FileAccess>();
+	}
+	return fa;
+}
+
+PackSourceQMod::PackSourceQMod() {
+	singleton = this;
+}
+
+PackSourceQMod::~PackSourceQMod() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
+
+/////////////////////////////////////////////////
+
+Error FileAccessQMod::open_range(const Ref<QModArchive> &p_archive, uint64_t p_offset, uint64_t p_size, const String &p_path) {
+	ERR_FAIL_COND_V(p_archive.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_offset > p_archive->get_data_size() || p_size > p_archive->get_data_size() - p_offset, ERR_FILE_CORRUPT);
+
+	archive = p_archive;
+	path = p_path;
+	data = archive->get_data() + p_offset;
+	length = p_size;
+	pos = 0;
+	eof = false;
+	return OK;
+}
+
+Error FileAccessQMod::open_compressed(const Ref<QModArchive> &p_archive, int p_index, const String &p_path) {
+	ERR_FAIL_COND_V(p_archive.is_null(), ERR_INVALID_PARAMETER);
+
+	contents.resize(p_archive->get_file_size(p_index));
+	Error err = p_archive->read_file(p_index, contents.ptrw());
+	if (err != OK) {
+		contents.clear();
+		return err;
+	}
+
+	// Nothing refers to the mapping anymore, the archive doesn't need to stay alive.
+	archive.unref();
+	path = p_path;
+	data = contents.ptr();
+	length = contents.size();
+	pos = 0;
+	eof = false;
+	return OK;
+}
+
+Error FileAccessQMod::open_internal(const String &p_path, int p_mode_flags) {
+	ERR_PRINT("Can't open QMOD archive files directly, they must be accessed through their mount point.");
+	return ERR_UNAVAILABLE;
+}
+
+bool FileAccessQMod::is_open() const {
+	return data != nullptr;
+}
+
+void FileAccessQMod::seek(uint64_t p_position) {
+	ERR_FAIL_NULL(data);
+	eof = p_position > length;
+	pos = MIN(p_position, length);
+}
+
+void FileAccessQMod::seek_end(int64_t p_position) {
+	ERR_FAIL_NULL(data);
+	seek(length + p_position);
+}
+
+uint64_t FileAccessQMod::get_position() const {
+	ERR_FAIL_NULL_V(data, 0);
+	return pos;
+}
+
+uint64_t FileAccessQMod::get_length() const {
+	ERR_FAIL_NULL_V(data, 0);
+	return length;
+}
+
+bool FileAccessQMod::eof_reached() const {
+	return eof;
+}
+
+uint64_t FileAccessQMod::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+	ERR_FAIL_NULL_V(data, -1);
+
+	if (eof) {
+		return 0;
+	}
+
+	uint64_t to_read = p_length;
+	if (to_read > length - pos) {
+		to_read = length - pos;
+		eof = true;
+	}
+
+	memcpy(p_dst, data + pos, to_read);
+	pos += to_read;
+	return to_read;
+}
+
+Error FileAccessQMod::get_error() const {
+	return eof ? ERR_FILE_EOF : OK;
+}
+
+void FileAccessQMod::flush() {
+	ERR_FAIL();
+}
+
+bool FileAccessQMod::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_V(false);
+}
+
+bool FileAccessQMod::file_exists(const String &p_name) {
+	return false;
+}
+
+void FileAccessQMod::close() {
+	archive.unref();
+	contents.clear();
+	data = nullptr;
+	length = 0;
+	pos = 0;
+}
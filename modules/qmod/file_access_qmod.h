@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  file_access_qmod.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "qmod_archive.h"
+
+#include "core/io/file_access_pack.h"
+#include "core/os/mutex.h"
+
+// Serves the files of mounted mods: either in place from a .qmod archive, or
+// from the content-addressed store through an installed mod's manifest.
+class PackSourceQMod : public PackSource {
+	HashMap<String, Ref<QModArchive>> archives;
+	HashMap<String, HashMap<String, String>> manifests; // Manifest path -> (virtual path -> blob path).
+	Mutex mutex;
+
+	static inline PackSourceQMod *singleton = nullptr;
+
+public:
+	static PackSourceQMod *get_singleton() { return singleton; }
+
+	Error mount(const String &p_archive_path, const String &p_mount_point, bool p_replace_files);
+	Error mount_manifest(const String &p_manifest_path, const String &p_mount_point, bool p_replace_files);
+	// Works for both archives and manifests.
+	void unmount(const String &p_path);
+	bool is_mounted(const String &p_path);
+
+	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
+	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+
+	PackSourceQMod();
+	~PackSourceQMod();
+};
+
+class FileAccessQMod : public FileAccess {
+	GDSOFTCLASS(FileAccessQMod, FileAccess);
+
+	Ref<QModArchive> archive; // Keeps the mapping alive while the file is open.
+	Vector<uint8_t> contents; // Compressed files are decompressed on open.
+	String path;
+	const uint8_t *data = nullptr;
+	uint64_t length = 0;
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+
+public:
+	Error open_range(const Ref<QModArchive> &p_archive, uint64_t p_offset, uint64_t p_size, const String &p_path);
+	Error open_compressed(const Ref<QModArchive> &p_archive, int p_index, const String &p_path);
+
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
+	virtual bool is_open() const override;
+
+	virtual const uint8_t *get_mapped_buffer() override { return data; }
+
+	virtual String get_path() const override { return path; }
+	virtual String get_path_absolute() const override { return path; }
+
+	virtual void seek(uint64_t p_position) override;
+	virtual void seek_end(int64_t p_position = 0) override;
+	virtual uint64_t get_position() const override;
+	virtual uint64_t get_length() const override;
+
+	virtual bool eof_reached() const override;
+
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+
+	virtual Error get_error() const override;
+
+	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
+	virtual void flush() override;
+	virtual bool store_buffer(const uint8_t *p_src, uint64_t p_length) override;
+
+	virtual bool file_exists(const String &p_name) override;
+
+	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
+	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
+	virtual int64_t _get_size(const String &p_file) override { return -1; }
+
+	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
+	virtual Error _set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) override { return FAILED; }
+
+	virtual bool _get_hidden_attribute(const String &p_file) override { return false; }
+	virtual Error _set_hidden_attribute(const String &p_file, bool p_hidden) override { return ERR_UNAVAILABLE; }
+	virtual bool _get_read_only_attribute(const String &p_file) override { return true; }
+	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override { return ERR_UNAVAILABLE; }
+
+	virtual void close() override;
+};
@@ -0,0 +1,513 @@
+/**************************************************************************/
+/*  qmod_archive.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "qmod_archive.h"
+
+#include "core/config/mod_security.h"
+#include "core/config/project_settings.h"
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/object/worker_thread_pool.h"
+
+#ifdef UNIX_ENABLED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+Error QModArchive::_map(const String &p_path) {
+#ifdef UNIX_ENABLED
+	String global_path = ProjectSettings::get_singleton() ? ProjectSettings::get_singleton()->globalize_path(p_path) : p_path;
+	if (!global_path.contains("://")) {
+		int fd = ::open(global_path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+		if (fd >= 0) {
+			struct stat st;
+			if (fstat(fd, &st) == 0 && st.st_size > 0) {
+				void *ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (ptr != MAP_FAILED) {
+					data = (const uint8_t *)ptr;
+					data_size = st.st_size;
+					mapped = true;
+				}
+			}
+			// The mapping stays valid after the descriptor is closed.
+			::close(fd);
+			if (mapped) {
+				return OK;
+			}
+		}
+	}
+#endif
+
+	// Not a plain OS file (e.g. inside a pack), or mapping isn't available: keep a copy in memory.
+	Error err = OK;
+	buffer = FileAccess::get_file_as_bytes(p_path, &err);
+	if (err != OK) {
+		return err;
+	}
+	data = buffer.ptr();
+	data_size = buffer.size();
+	return OK;
+}
+
+void QModArchive::_unmap() {
+#ifdef UNIX_ENABLED
+	if (mapped) {
+		munmap((void *)data, data_size);
+	}
+#endif
+	buffer.clear();
+	data = nullptr;
+	data_size = 0;
+	mapped = false;
+	file_count = 0;
+	chunk_size = 0;
+	index = nullptr;
+	strings = nullptr;
+	strings_size = 0;
+	compressed_files.clear();
+}
+
+bool QModArchive::is_valid_entry_path(const String &p_path) {
+	// No absolute paths, drive letters or schemes, and no way back up out of the mount point.
+	if (p_path.is_empty() || p_path.begins_with("/") || p_path.contains_char(':') || p_path.contains_char('\\')) {
+		return false;
+	}
+	for (const String &segment : p_path.split("/")) {
+		if (segment == "..") {
+			return false;
+		}
+	}
+	return true;
+}
+
+Error QModArchive::_parse_header() {
+	ERR_FAIL_COND_V_MSG(data_size < QMOD_HEADER_SIZE, ERR_FILE_CORRUPT, vformat("QMOD archive is truncated: '%s'.", path));
+
+	uint32_t magic = decode_uint32(data);
+	ERR_FAIL_COND_V_MSG(magic != QMOD_MAGIC, ERR_FILE_UNRECOGNIZED, vformat("Not a QMOD archive: '%s'.", path));
+
+	uint32_t version = decode_uint32(data + 4);
+	ERR_FAIL_COND_V_MSG(version > QMOD_FORMAT_VERSION, ERR_FILE_UNRECOGNIZED, vformat("QMOD archive '%s' uses format version %d, which is newer than the supported version %d.", path, version, QMOD_FORMAT_VERSION));
+
+	// Offset 8 holds archive flags, none are defined yet.
+	uint32_t count = decode_uint32(data + 12);
+	uint64_t index_offset = decode_uint64(data + 16);
+	uint64_t strings_offset = decode_uint64(data + 24);
+	uint64_t str_size = decode_uint64(data + 32);
+	entry_size = version >= 2 ? QMOD_INDEX_ENTRY_SIZE : QMOD_INDEX_ENTRY_SIZE_V1;
+	uint32_t chunk = version >= 2 ? decode_uint32(data + 40) : 0;
+
+	ERR_FAIL_COND_V_MSG(index_offset > data_size || (uint64_t)count * entry_size > data_size - index_offset, ERR_FILE_CORRUPT, vformat("QMOD archive has an invalid index: '%s'.", path));
+	ERR_FAIL_COND_V_MSG(strings_offset > data_size || str_size > data_size - strings_offset, ERR_FILE_CORRUPT, vformat("QMOD archive has an invalid string table: '%s'.", path));
+
+	// Validate every entry once so lookups never have to bounds-check.
+	const uint8_t *entries = data + index_offset;
+	uint64_t prev_hash = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const uint8_t *entry = entries + (uint64_t)i * entry_size;
+		uint64_t hash = decode_uint64(entry);
+		uint64_t offset = decode_uint64(entry + 8);
+		uint64_t size = decode_uint64(entry + 16);
+		uint32_t path_offset = decode_uint32(entry + 24);
+		uint32_t path_length = decode_uint32(entry + 28);
+		uint64_t stored_size = version >= 2 ? decode_uint64(entry + 32) : size;
+		uint32_t flags = version >= 2 ? decode_uint32(entry + 40) : 0;
+
+		ERR_FAIL_COND_V_MSG(hash < prev_hash, ERR_FILE_CORRUPT, vformat("QMOD archive index is not sorted: '%s'.", path));
+		ERR_FAIL_COND_V_MSG(offset > data_size || stored_size > data_size - offset, ERR_FILE_CORRUPT, vformat("QMOD archive entry %d is out of bounds: '%s'.", i, path));
+		ERR_FAIL_COND_V_MSG((uint64_t)path_offset + path_length > str_size, ERR_FILE_CORRUPT, vformat("QMOD archive entry %d has an invalid path: '%s'.", i, path));
+		ERR_FAIL_COND_V_MSG(!is_valid_entry_path(String::utf8((const char *)data + strings_offset + path_offset, path_length)), ERR_FILE_CORRUPT, vformat("QMOD archive entry %d has an invalid path: '%s'.", i, path));
+		if (flags & QMOD_FILE_COMPRESSED) {
+			ERR_FAIL_COND_V_MSG(chunk == 0 || (size + chunk - 1) / chunk * 4 > stored_size, ERR_FILE_CORRUPT, vformat("QMOD archive entry %d has an invalid chunk table: '%s'.", i, path));
+			compressed_files[offset] = i;
+		} else {
+			ERR_FAIL_COND_V_MSG(stored_size != size, ERR_FILE_CORRUPT, vformat("QMOD archive entry %d has an invalid size: '%s'.", i, path));
+		}
+		prev_hash = hash;
+	}
+
+	file_count = count;
+	chunk_size = chunk;
+	index = entries;
+	strings = data + strings_offset;
+	strings_size = str_size;
+	return OK;
+}
+
+Error QModArchive::open(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(!ModSecurity::is_path_allowed(p_path), ERR_FILE_NO_PERMISSION, ModSecurity::get_access_denied_message(p_path));
+
+	_unmap();
+	path = p_path;
+
+	Error err = _map(p_path);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Can't open QMOD archive: '%s'.", p_path));
+
+	err = _parse_header();
+	if (err != OK) {
+		_unmap();
+	}
+	return err;
+}
+
+int QModArchive::find_file(const String &p_path) const {
+	// Same normalization as PackedData, so "a/../b" and "a//b" find their entries.
+	String path = normalize_path(p_path);
+	uint64_t hash = hash_path(path);
+
+	// Lower bound on the sorted hashes, then check the (rare) collisions by name.
+	uint32_t low = 0;
+	uint32_t high = file_count;
+	while (low < high) {
+		uint32_t middle = low + (high - low) / 2;
+		if (decode_uint64(_get_entry(middle)) < hash) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	for (uint32_t i = low; i < file_count && decode_uint64(_get_entry(i)) == hash; i++) {
+		if (get_file_path(i) == path) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+String QModArchive::get_file_path(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)file_count, String());
+	const uint8_t *entry = _get_entry(p_index);
+	return String::utf8((const char *)strings + decode_uint32(entry + 24), decode_uint32(entry + 28));
+}
+
+uint64_t QModArchive::get_file_offset(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)file_count, 0);
+	return decode_uint64(_get_entry(p_index) + 8);
+}
+
+uint64_t QModArchive::get_file_size(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)file_count, 0);
+	return decode_uint64(_get_entry(p_index) + 16);
+}
+
+uint64_t QModArchive::get_file_stored_size(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)file_count, 0);
+	return entry_size >= QMOD_INDEX_ENTRY_SIZE ? decode_uint64(_get_entry(p_index) + 32) : get_file_size(p_index);
+}
+
+bool QModArchive::is_file_compressed(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)file_count, false);
+	return entry_size >= QMOD_INDEX_ENTRY_SIZE && (decode_uint32(_get_entry(p_index) + 40) & QMOD_FILE_COMPRESSED);
+}
+
+int QModArchive::find_compressed_file(uint64_t p_offset) const {
+	HashMap<uint64_t, int>::ConstIterator E = compressed_files.find(p_offset);
+	return E ? E->value : -1;
+}
+
+const uint8_t *QModArchive::get_file_data(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, (int)file_count, nullptr);
+	return data + decode_uint64(_get_entry(p_index) + 8);
+}
+
+Error QModArchive::read_file(int p_index, uint8_t *r_dst) const {
+	ERR_FAIL_INDEX_V(p_index, (int)file_count, ERR_INVALID_PARAMETER);
+	const uint8_t *src = get_file_data(p_index);
+	uint64_t size = get_file_size(p_index);
+	if (!is_file_compressed(p_index)) {
+		memcpy(r_dst, src, size);
+		return OK;
+	}
+
+	// Chunk sizes were checked to fit the table by _parse_header(), their contents weren't.
+	uint64_t chunk_count = (size + chunk_size - 1) / chunk_size;
+	const uint8_t *chunk = src + chunk_count * 4;
+	uint64_t remaining = get_file_stored_size(p_index) - chunk_count * 4;
+	for (uint64_t i = 0; i < chunk_count; i++) {
+		uint32_t stored = decode_uint32(src + i * 4);
+		uint64_t expected = MIN((uint64_t)chunk_size, size - i * chunk_size);
+		ERR_FAIL_COND_V_MSG(stored > remaining, ERR_FILE_CORRUPT, vformat("QMOD archive chunk is out of bounds: '%s'.", path));
+
+		if (stored == expected) {
+			memcpy(r_dst + i * chunk_size, chunk, stored); // Didn't compress.
+		} else {
+			int64_t decompressed = Compression::decompress(r_dst + i * chunk_size, expected, chunk, stored, Compression::MODE_ZSTD);
+			ERR_FAIL_COND_V_MSG(decompressed != (int64_t)expected, ERR_FILE_CORRUPT, vformat("QMOD archive chunk can't be decompressed: '%s'.", path));
+		}
+		chunk += stored;
+		remaining -= stored;
+	}
+	return OK;
+}
+
+String QModArchive::get_file_as_string(const String &p_path, Error *r_error) const {
+	int idx = find_file(p_path);
+	if (r_error) {
+		*r_error = idx < 0 ? ERR_FILE_NOT_FOUND : OK;
+	}
+	if (idx < 0) {
+		return String();
+	}
+	if (!is_file_compressed(idx)) {
+		return String::utf8((const char *)get_file_data(idx), get_file_size(idx));
+	}
+
+	Vector<uint8_t> contents;
+	contents.resize(get_file_size(idx));
+	Error err = read_file(idx, contents.ptrw());
+	if (r_error) {
+		*r_error = err;
+	}
+	return err == OK ? String::utf8((const char *)contents.ptr(), contents.size()) : String();
+}
+
+QModArchive::~QModArchive() {
+	_unmap();
+}
+
+/////////////////////////////////////////////////
+
+Error QModArchiveWriter::open(const String &p_path) {
+	Error err = OK;
+	file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Can't open QMOD archive for writing: '%s'.", p_path));
+
+	// Reserve room for the header, finish() writes it once the index location is known.
+	uint8_t header[QMOD_HEADER_SIZE] = {};
+	file->store_buffer(header, QMOD_HEADER_SIZE);
+	entries.clear();
+	return OK;
+}
+
+Error QModArchiveWriter::_begin_entry(const String &p_path) {
+	ERR_FAIL_COND_V(file.is_null(), ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V_MSG(!QModArchive::is_valid_entry_path(p_path), ERR_INVALID_PARAMETER, vformat("Invalid QMOD archive path: '%s'.", p_path));
+	for (const Entry &E : entries) {
+		ERR_FAIL_COND_V_MSG(E.path == p_path, ERR_ALREADY_EXISTS, vformat("Duplicate QMOD archive path: '%s'.", p_path));
+	}
+
+	uint64_t position = file->get_position();
+	uint64_t padding = (QMOD_DATA_ALIGNMENT - position % QMOD_DATA_ALIGNMENT) % QMOD_DATA_ALIGNMENT;
+	for (uint64_t i = 0; i < padding; i++) {
+		file->store_8(0);
+	}
+
+	Entry entry;
+	entry.path = p_path;
+	entry.hash = QModArchive::hash_path(p_path);
+	entry.offset = file->get_position();
+	entries.push_back(entry);
+	return OK;
+}
+
+Error QModArchiveWriter::add_buffer(const String &p_path, const uint8_t *p_data, uint64_t p_size) {
+	String path = QModArchive::normalize_path(p_path);
+	Error err = _begin_entry(path);
+	if (err != OK) {
+		return err;
+	}
+
+	if (p_size > 0 && !file->store_buffer(p_data, p_size)) {
+		return ERR_FILE_CANT_WRITE;
+	}
+	entries[entries.size() - 1].size = p_size;
+	entries[entries.size() - 1].stored_size = p_size;
+	return OK;
+}
+
+Error QModArchiveWriter::add_file(const String &p_path, const String &p_source_path, bool p_compress) {
+	Error err = OK;
+	Ref<FileAccess> src = FileAccess::open(p_source_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(src.is_null(), err, vformat("Can't open file to add to QMOD archive: '%s'.", p_source_path));
+
+	String path = QModArchive::normalize_path(p_path);
+	err = _begin_entry(path);
+	if (err != OK) {
+		return err;
+	}
+	Entry &entry = entries[entries.size() - 1];
+
+	if (p_compress && src->get_length() > 0) {
+		err = _add_file_compressed(entry, src);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Can't add file to QMOD archive: '%s'.", p_source_path));
+		return OK;
+	}
+
+	// Copy in fixed-size chunks so large assets don't need to fit in memory.
+	const uint64_t copy_size = 65536;
+	LocalVector<uint8_t> buffer;
+	buffer.resize(copy_size);
+	uint64_t total = 0;
+	while (true) {
+		uint64_t read = src->get_buffer(buffer.ptr(), copy_size);
+		if (read == 0) {
+			break;
+		}
+		if (!file->store_buffer(buffer.ptr(), read)) {
+			return ERR_FILE_CANT_WRITE;
+		}
+		total += read;
+	}
+	entry.size = total;
+	entry.stored_size = total;
+	return OK;
+}
+
+void QModArchiveWriter::_compress_chunk(uint32_t p_index, Chunk *p_chunks) {
+	Chunk &chunk = p_chunks[p_index];
+	chunk.compressed_size = Compression::compress(chunk.compressed.ptrw(), chunk.source.ptr(), chunk.source_size, Compression::MODE_ZSTD);
+}
+
+Error QModArchiveWriter::_add_file_compressed(Entry &r_entry, const Ref<FileAccess> &p_source) {
+	uint64_t size = p_source->get_length();
+	uint64_t chunk_count = (size + QMOD_CHUNK_SIZE - 1) / QMOD_CHUNK_SIZE;
+
+	// A batch of chunks is read, compressed in parallel and written out in order,
+	// so memory use depends on the number of threads, not on the file size.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	uint32_t batch_size = pool ? MAX(1, pool->get_thread_count() * 2) : 1;
+	if (chunks.size() < batch_size) {
+		int64_t max_compressed = Compression::get_max_compressed_buffer_size(QMOD_CHUNK_SIZE, Compression::MODE_ZSTD);
+		uint32_t first_new = chunks.size();
+		chunks.resize(batch_size);
+		for (uint32_t i = first_new; i < batch_size; i++) {
+			chunks[i].source.resize(QMOD_CHUNK_SIZE);
+			chunks[i].compressed.resize(max_compressed);
+		}
+	}
+
+	// The chunk sizes are only known once compressed, leave room for the table.
+	uint64_t table_position = file->get_position();
+	for (uint64_t i = 0; i < chunk_count; i++) {
+		file->store_32(0);
+	}
+
+	LocalVector<uint32_t> stored_sizes;
+	stored_sizes.resize(chunk_count);
+	for (uint64_t first = 0; first < chunk_count; first += batch_size) {
+		uint32_t count = MIN((uint64_t)batch_size, chunk_count - first);
+		for (uint32_t i = 0; i < count; i++) {
+			Chunk &chunk = chunks[i];
+			uint64_t expected = MIN((uint64_t)QMOD_CHUNK_SIZE, size - (first + i) * QMOD_CHUNK_SIZE);
+			chunk.source_size = p_source->get_buffer(chunk.source.ptrw(), expected);
+			// The file changed while it was being read.
+			ERR_FAIL_COND_V(chunk.source_size != expected, ERR_FILE_CORRUPT);
+		}
+
+		if (count > 1) {
+			WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &QModArchiveWriter::_compress_chunk, chunks.ptr(), count, -1, true, SNAME("QModCompressChunks"));
+			pool->wait_for_group_task_completion(group);
+		} else {
+			_compress_chunk(0, chunks.ptr());
+		}
+
+		for (uint32_t i = 0; i < count; i++) {
+			const Chunk &chunk = chunks[i];
+			// Incompressible data (images, audio) is stored as is, readers tell by the size.
+			bool compressed = chunk.compressed_size > 0 && (uint64_t)chunk.compressed_size < chunk.source_size;
+			const uint8_t *stored = compressed ? chunk.compressed.ptr() : chunk.source.ptr();
+			stored_sizes[first + i] = compressed ? chunk.compressed_size : chunk.source_size;
+			if (!file->store_buffer(stored, stored_sizes[first + i])) {
+				return ERR_FILE_CANT_WRITE;
+			}
+		}
+	}
+
+	uint64_t end = file->get_position();
+	file->seek(table_position);
+	for (uint32_t stored : stored_sizes) {
+		file->store_32(stored);
+	}
+	file->seek(end);
+
+	r_entry.size = size;
+	r_entry.stored_size = end - r_entry.offset;
+	r_entry.flags |= QMOD_FILE_COMPRESSED;
+	return file->get_error();
+}
+
+Error QModArchiveWriter::finish() {
+	ERR_FAIL_COND_V(file.is_null(), ERR_UNCONFIGURED);
+
+	struct EntrySort {
+		_FORCE_INLINE_ bool operator()(const Entry &p_a, const Entry &p_b) const {
+			return p_a.hash != p_b.hash ? p_a.hash < p_b.hash : p_a.path < p_b.path;
+		}
+	};
+	entries.sort_custom<EntrySort>();
+
+	LocalVector<CharString> paths;
+	paths.resize(entries.size());
+
+	uint64_t index_offset = file->get_position();
+	uint32_t path_offset = 0;
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		paths[i] = entries[i].path.utf8();
+		file->store_64(entries[i].hash);
+		file->store_64(entries[i].offset);
+		file->store_64(entries[i].size);
+		file->store_32(path_offset);
+		file->store_32(paths[i].length());
+		file->store_64(entries[i].stored_size);
+		file->store_32(entries[i].flags);
+		file->store_32(0); // Reserved.
+		path_offset += paths[i].length();
+	}
+
+	uint64_t strings_offset = file->get_position();
+	for (const CharString &path : paths) {
+		file->store_buffer((const uint8_t *)path.get_data(), path.length());
+	}
+
+	file->seek(0);
+	file->store_32(QMOD_MAGIC);
+	file->store_32(QMOD_FORMAT_VERSION);
+	file->store_32(0); // Flags.
+	file->store_32(entries.size());
+	file->store_64(index_offset);
+	file->store_64(strings_offset);
+	file->store_64(path_offset);
+	file->store_32(QMOD_CHUNK_SIZE);
+
+	Error err = file->get_error();
+	file->close();
+	file.unref();
+	entries.clear();
+	return err;
+}
+
+QModArchiveWriter::~QModArchiveWriter() {
+	if (file.is_valid()) {
+		file->close();
+	}
+}
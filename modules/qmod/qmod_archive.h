@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*  qmod_archive.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Single-file .qmod archive, all integers little endian:
+//
+//   Header   QMOD_HEADER_SIZE bytes (magic, version, file count, index and string table location).
+//   Blobs    File contents, each one starting on a QMOD_DATA_ALIGNMENT boundary.
+//   Index    One QMOD_INDEX_ENTRY_SIZE entry per file, sorted by path hash.
+//   Strings  UTF-8 paths relative to the archive root, referenced by the index.
+//
+// The index is written last so blobs can be streamed out without knowing the
+// file set up front; the header is patched once everything else is on disk.
+//
+// Version 2 adds the stored size and flags to each index entry, and the chunk
+// size to the header. Files flagged QMOD_FILE_COMPRESSED are split into chunks
+// of that size which are compressed independently with zstd (or stored as is,
+// when compressing doesn't make them smaller), and stored as a table of u32
+// chunk sizes followed by the chunks.
+
+#define QMOD_MAGIC 0x444F4D51 // "QMOD"
+#define QMOD_FORMAT_VERSION 2
+#define QMOD_HEADER_SIZE 64
+#define QMOD_INDEX_ENTRY_SIZE 48
+#define QMOD_INDEX_ENTRY_SIZE_V1 32
+#define QMOD_DATA_ALIGNMENT 64
+#define QMOD_CHUNK_SIZE (256 * 1024)
+
+enum {
+	QMOD_FILE_COMPRESSED = 1,
+};
+
+class QModArchive : public RefCounted {
+	GDSOFTCLASS(QModArchive, RefCounted);
+
+	String path;
+
+	const uint8_t *data = nullptr;
+	uint64_t data_size = 0;
+	bool mapped = false;
+	Vector<uint8_t> buffer; // Fallback storage when the archive can't be memory-mapped.
+
+	uint32_t file_count = 0;
+	uint32_t entry_size = QMOD_INDEX_ENTRY_SIZE;
+	uint32_t chunk_size = 0;
+	const uint8_t *index = nullptr;
+	const uint8_t *strings = nullptr;
+	uint64_t strings_size = 0;
+	HashMap<uint64_t, int> compressed_files; // Offset to index, for mounted files.
+
+	Error _map(const String &p_path);
+	void _unmap();
+	Error _parse_header();
+
+	_FORCE_INLINE_ const uint8_t *_get_entry(int p_index) const { return index + (uint64_t)p_index * entry_size; }
+
+public:
+	static uint64_t hash_path(const String &p_path) { return p_path.hash64(); }
+	static String normalize_path(const String &p_path) { return p_path.simplify_path().trim_prefix("res://"); }
+	// Entry paths are mounted below a mod's own directory, so they must stay relative and inside it.
+	static bool is_valid_entry_path(const String &p_path);
+
+	Error open(const String &p_path);
+	String get_path() const { return path; }
+	bool is_memory_mapped() const { return mapped; }
+
+	int get_file_count() const { return file_count; }
+	int find_file(const String &p_path) const;
+	String get_file_path(int p_index) const;
+	uint64_t get_file_offset(int p_index) const;
+	uint64_t get_file_size(int p_index) const;
+	uint64_t get_file_stored_size(int p_index) const;
+	bool is_file_compressed(int p_index) const;
+	int find_compressed_file(uint64_t p_offset) const;
+
+	// Zero-copy access to the archive contents, valid for as long as this archive is referenced.
+	// For compressed files this is the stored data, use read_file() to get the contents.
+	const uint8_t *get_data() const { return data; }
+	uint64_t get_data_size() const { return data_size; }
+	const uint8_t *get_file_data(int p_index) const;
+
+	// Copies the file contents, decompressing them if needed, into `r_dst`, which must hold get_file_size() bytes.
+	Error read_file(int p_index, uint8_t *r_dst) const;
+
+	String get_file_as_string(const String &p_path, Error *r_error = nullptr) const;
+
+	~QModArchive();
+};
+
+class QModArchiveWriter {
+	struct Entry {
+		String path;
+		uint64_t hash = 0;
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		uint64_t stored_size = 0;
+		uint32_t flags = 0;
+	};
+
+	struct Chunk {
+		Vector<uint8_t> source;
+		Vector<uint8_t> compressed;
+		uint64_t source_size = 0;
+		int64_t compressed_size = 0;
+	};
+
+	Ref<FileAccess> file;
+	LocalVector<Entry> entries;
+	LocalVector<Chunk> chunks; // Reused by every compressed file.
+
+	Error _begin_entry(const String &p_path);
+	Error _add_file_compressed(Entry &r_entry, const Ref<FileAccess> &p_source);
+	void _compress_chunk(uint32_t p_index, Chunk *p_chunks);
+
+public:
+	Error open(const String &p_path);
+	Error add_buffer(const String &p_path, const uint8_t *p_data, uint64_t p_size);
+	// Streams the file in, compressing batches of chunks on the worker thread pool if requested.
+	Error add_file(const String &p_path, const String &p_source_path, bool p_compress = false);
+	Error finish();
+
+	~QModArchiveWriter();
+};
@@ -0,0 +1,448 @@
+/**************************************************************************/
+/*  qmod_catalog.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "qmod_catalog.h"
+
+#include "qmod_loader.h"
+#include "qmod_store.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/templates/hash_set.h"
+
+String QModCatalog::get_catalog_path() {
+	return QModLoader::get_mods_directory() + "/.catalog/index";
+}
+
+uint64_t QModCatalog::_get_directory_modified_time() {
+	String mods_dir = QModLoader::get_mods_directory();
+	if (!DirAccess::dir_exists_absolute(mods_dir)) {
+		return 0;
+	}
+	return FileAccess::get_modified_time(mods_dir);
+}
+
+bool QModCatalog::_get_mod_stamp(const String &p_mod_name, Entry &r_entry) {
+	r_entry.modified_time = 0;
+	r_entry.size = 0;
+	r_entry.hash = String();
+
+	String path = QModStore::get_manifest_path(p_mod_name);
+	bool hashed = true;
+	if (!FileAccess::exists(path)) {
+		path = QModLoader::_get_archive_path(p_mod_name);
+		hashed = false;
+		if (!FileAccess::exists(path)) {
+			// Legacy mods are plain directories, whose mod.json can change in place.
+			path = QModLoader::get_mods_directory() + "/" + p_mod_name + "/mod.json";
+			hashed = true;
+			if (!FileAccess::exists(path)) {
+				return false;
+			}
+		}
+	}
+
+	r_entry.modified_time = FileAccess::get_modified_time(path);
+	if (hashed) {
+		// Manifests and mod.json are small, and the manifest lists the hashes of every file of the mod.
+		Error err = OK;
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(path, &err);
+		if (err != OK) {
+			return false;
+		}
+		r_entry.size = data.size();
+		r_entry.hash = QModStore::hash_buffer(data.ptr(), data.size());
+	} else {
+		r_entry.size = FileAccess::get_size(path);
+	}
+	return r_entry.modified_time != 0;
+}
+
+void QModCatalog::_fill_entry(Entry &r_entry, const String &p_mod_name, const Dictionary &p_metadata) {
+	r_entry.name = p_mod_name;
+	r_entry.title = String(p_metadata.get("title", "")).to_lower();
+	r_entry.type = p_metadata.get("type", "");
+	r_entry.info = p_metadata.duplicate();
+	r_entry.info["mod_directory"] = QModLoader::get_mods_directory() + "/" + p_mod_name;
+}
+
+Error QModCatalog::_store_variant(const Ref<FileAccess> &p_file, const Variant &p_value, Vector<uint8_t> &r_buffer) {
+	int len = 0;
+	Error err = encode_variant(p_value, nullptr, len);
+	if (err != OK) {
+		return err;
+	}
+	r_buffer.resize(len);
+	encode_variant(p_value, r_buffer.ptrw(), len);
+	p_file->store_buffer(r_buffer.ptr(), len);
+	return OK;
+}
+
+Error QModCatalog::_load() {
+	entries.clear();
+	directory_modified_time = 0;
+
+	String path = get_catalog_path();
+	if (!FileAccess::exists(path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	Error err = OK;
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(path, &err);
+	if (err != OK) {
+		return err;
+	}
+
+	const uint8_t *ptr = data.ptr();
+	int64_t remaining = data.size();
+	ERR_FAIL_COND_V_MSG(remaining < 20 || decode_uint32(ptr) != QMOD_CATALOG_MAGIC, ERR_FILE_UNRECOGNIZED, vformat("Not a mod catalog: '%s'.", path));
+	if (decode_uint32(ptr + 4) != QMOD_CATALOG_VERSION) {
+		// Written by another version, rebuilt by the next rescan.
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	uint64_t modified_time = decode_uint64(ptr + 8);
+	uint32_t count = decode_uint32(ptr + 16);
+	ptr += 20;
+	remaining -= 20;
+
+	// Each entry takes at least its stamp and the headers of an encoded String and Dictionary,
+	// so a corrupt count is caught before allocating. The next query rescans the mods directory.
+	const int64_t min_entry_size = 8 + 8 + 32 + 8 + 8;
+	ERR_FAIL_COND_V_MSG(count > remaining / min_entry_size, ERR_FILE_CORRUPT, vformat("Mod catalog is corrupt: '%s'.", path));
+	entries.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		Entry &entry = entries[i];
+		Variant name;
+		Variant metadata;
+		int len = 0;
+		if (remaining < 8 + 8 + 32) {
+			err = ERR_FILE_CORRUPT;
+			break;
+		}
+		entry.modified_time = decode_uint64(ptr);
+		entry.size = decode_uint64(ptr + 8);
+		bool hashed = false;
+		for (int j = 0; j < 32; j++) {
+			hashed = hashed || ptr[16 + j] != 0;
+		}
+		entry.hash = hashed ? String::hex_encode_buffer(ptr + 16, 32) : String();
+		ptr += 8 + 8 + 32;
+		remaining -= 8 + 8 + 32;
+
+		err = decode_variant(name, ptr, remaining, &len);
+		if (err != OK || name.get_type() != Variant::STRING) {
+			err = ERR_FILE_CORRUPT;
+			break;
+		}
+		ptr += len;
+		remaining -= len;
+
+		err = decode_variant(metadata, ptr, remaining, &len);
+		if (err != OK || metadata.get_type() != Variant::DICTIONARY) {
+			err = ERR_FILE_CORRUPT;
+			break;
+		}
+		ptr += len;
+		remaining -= len;
+
+		_fill_entry(entry, name, metadata);
+	}
+
+	if (err != OK) {
+		entries.clear();
+		ERR_FAIL_V_MSG(err, vformat("Mod catalog is corrupt: '%s'.", path));
+	}
+
+	directory_modified_time = modified_time;
+	_rebuild_indices();
+	return OK;
+}
+
+Error QModCatalog::_save() {
+	String path = get_catalog_path();
+	Error err = DirAccess::make_dir_recursive_absolute(path.get_base_dir());
+	if (err != OK && err != ERR_ALREADY_EXISTS) {
+		return err;
+	}
+	// Taken after creating the catalog directory, which itself changes it.
+	directory_modified_time = _get_directory_modified_time();
+
+	String temp_path = path + ".tmp";
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+		if (f.is_null()) {
+			return ERR_FILE_CANT_WRITE;
+		}
+
+		f->store_32(QMOD_CATALOG_MAGIC);
+		f->store_32(QMOD_CATALOG_VERSION);
+		f->store_64(directory_modified_time);
+		f->store_32(entries.size());
+
+		Vector<uint8_t> buffer;
+		for (const Entry &entry : entries) {
+			f->store_64(entry.modified_time);
+			f->store_64(entry.size);
+			uint8_t hash[32] = {};
+			if (!entry.hash.is_empty()) {
+				Vector<uint8_t> decoded = entry.hash.hex_decode();
+				ERR_FAIL_COND_V(decoded.size() != 32, ERR_INVALID_DATA);
+				memcpy(hash, decoded.ptr(), 32);
+			}
+			f->store_buffer(hash, 32);
+			err = _store_variant(f, entry.name, buffer);
+			ERR_FAIL_COND_V(err != OK, err);
+			err = _store_variant(f, entry.info, buffer);
+			ERR_FAIL_COND_V(err != OK, err);
+		}
+
+		if (f->get_error() != OK) {
+			return ERR_FILE_CANT_WRITE;
+		}
+	}
+
+	err = DirAccess::rename_absolute(temp_path, path);
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+	return err;
+}
+
+void QModCatalog::_rescan() {
+	Vector<String> names;
+	Ref<DirAccess> dir = DirAccess::open(QModLoader::get_mods_directory());
+	if (dir.is_valid()) {
+		HashSet<String> found;
+		dir->list_dir_begin();
+		String file_name = dir->get_next();
+		while (!file_name.is_empty()) {
+			// Skips the store and the catalog itself.
+			if (!file_name.begins_with(".")) {
+				String mod_name;
+				if (dir->current_is_dir()) {
+					mod_name = file_name;
+				} else if (file_name.get_extension() == "qmod" || file_name.get_extension() == "manifest") {
+					mod_name = file_name.get_basename();
+				}
+				if (!mod_name.is_empty() && !found.has(mod_name)) {
+					found.insert(mod_name);
+					names.push_back(mod_name);
+				}
+			}
+			file_name = dir->get_next();
+		}
+		dir->list_dir_end();
+	}
+	names.sort();
+
+	LocalVector<Entry> scanned;
+	scanned.reserve(names.size());
+	for (const String &mod_name : names) {
+		Entry stamp;
+		bool stamped = _get_mod_stamp(mod_name, stamp);
+
+		HashMap<String, uint32_t>::ConstIterator E = entry_indices.find(mod_name);
+		if (E && stamped && entries[E->value].has_stamp_of(stamp)) {
+			scanned.push_back(entries[E->value]);
+			continue;
+		}
+
+		Dictionary metadata;
+		if (QModLoader::_read_metadata(mod_name, metadata) != OK) {
+			continue;
+		}
+		_fill_entry(stamp, mod_name, metadata);
+		scanned.push_back(stamp);
+	}
+
+	entries = scanned;
+	_rebuild_indices();
+
+	Error err = _save();
+	if (err != OK) {
+		ERR_PRINT(vformat("Could not save mod catalog: '%s'.", get_catalog_path()));
+		// Still valid for this session.
+		directory_modified_time = _get_directory_modified_time();
+	}
+}
+
+void QModCatalog::_update() {
+	if (!loaded) {
+		loaded = true;
+		_load();
+	}
+	if (_get_directory_modified_time() != directory_modified_time) {
+		_rescan();
+	}
+}
+
+void QModCatalog::_rebuild_indices() {
+	entry_indices.clear();
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		entry_indices.insert(entries[i].name, i);
+	}
+	query_cached = false;
+}
+
+const LocalVector<uint32_t> *QModCatalog::_get_rows(const String &p_type, const String &p_title) {
+	if (p_type.is_empty() && p_title.is_empty()) {
+		return nullptr; // Every entry, in order.
+	}
+	if (query_cached && query_type == p_type && query_title == p_title) {
+		return &query_rows;
+	}
+
+	String title = p_title.to_lower();
+	query_rows.clear();
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		const Entry &entry = entries[i];
+		if (!p_type.is_empty() && entry.type != p_type) {
+			continue;
+		}
+		if (!title.is_empty() && !entry.title.contains(title)) {
+			continue;
+		}
+		query_rows.push_back(i);
+	}
+
+	query_cached = true;
+	query_type = p_type;
+	query_title = p_title;
+	return &query_rows;
+}
+
+void QModCatalog::set_mod(const String &p_mod_name, const Dictionary &p_metadata) {
+	MutexLock lock(mutex);
+	_update();
+
+	Entry entry;
+	_get_mod_stamp(p_mod_name, entry);
+	_fill_entry(entry, p_mod_name, p_metadata);
+
+	HashMap<String, uint32_t>::ConstIterator E = entry_indices.find(p_mod_name);
+	if (E) {
+		entries[E->value] = entry;
+	} else {
+		uint32_t pos = 0;
+		while (pos < entries.size() && entries[pos].name < p_mod_name) {
+			pos++;
+		}
+		entries.insert(pos, entry);
+	}
+	_rebuild_indices();
+
+	if (_save() != OK) {
+		ERR_PRINT(vformat("Could not save mod catalog: '%s'.", get_catalog_path()));
+	}
+}
+
+void QModCatalog::remove_mod(const String &p_mod_name) {
+	MutexLock lock(mutex);
+	_update();
+
+	HashMap<String, uint32_t>::ConstIterator E = entry_indices.find(p_mod_name);
+	if (E) {
+		entries.remove_at(E->value);
+		_rebuild_indices();
+	}
+
+	if (_save() != OK) {
+		ERR_PRINT(vformat("Could not save mod catalog: '%s'.", get_catalog_path()));
+	}
+}
+
+PackedStringArray QModCatalog::get_mod_names() {
+	MutexLock lock(mutex);
+	_update();
+
+	PackedStringArray names;
+	names.resize(entries.size());
+	for (uint32_t i = 0; i < entries.size(); i++) {
+		names.write[i] = entries[i].name;
+	}
+	return names;
+}
+
+bool QModCatalog::has_mod(const String &p_mod_name) {
+	MutexLock lock(mutex);
+	_update();
+	return entry_indices.has(p_mod_name);
+}
+
+Dictionary QModCatalog::get_mod_info(const String &p_mod_name) {
+	MutexLock lock(mutex);
+	_update();
+
+	HashMap<String, uint32_t>::ConstIterator E = entry_indices.find(p_mod_name);
+	if (!E) {
+		return Dictionary();
+	}
+	// Callers may modify what they get back.
+	return entries[E->value].info.duplicate();
+}
+
+int QModCatalog::get_mod_count(const String &p_type, const String &p_title) {
+	MutexLock lock(mutex);
+	_update();
+
+	const LocalVector<uint32_t> *rows = _get_rows(p_type, p_title);
+	return rows ? rows->size() : entries.size();
+}
+
+Array QModCatalog::query_mods(int p_offset, int p_count, const String &p_type, const String &p_title) {
+	Array mods;
+	ERR_FAIL_COND_V(p_offset < 0 || p_count < 0, mods);
+
+	MutexLock lock(mutex);
+	_update();
+
+	const LocalVector<uint32_t> *rows = _get_rows(p_type, p_title);
+	uint64_t total = rows ? rows->size() : entries.size();
+	uint64_t end = MIN(total, (uint64_t)p_offset + p_count);
+	for (uint64_t i = p_offset; i < end; i++) {
+		const Entry &entry = entries[rows ? (*rows)[i] : i];
+		mods.push_back(entry.info.duplicate());
+	}
+	return mods;
+}
+
+QModCatalog::QModCatalog() {
+	// Only the catalog created by the module is the singleton, further ones (e.g. in tests) are standalone.
+	if (!singleton) {
+		singleton = this;
+	}
+}
+
+QModCatalog::~QModCatalog() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  qmod_catalog.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/array.h"
+#include "core/variant/dictionary.h"
+
+// Metadata of every installed mod, kept in `user://mods/.catalog/index` so
+// listing mods doesn't mean mounting each of them and parsing its mod.json.
+// Install and uninstall update the catalog in place. Anything else touching
+// the mods directory changes its modification time, and the next query
+// rescans it, re-reading only the mods whose manifest, archive or mod.json
+// changed. Modification times only have a resolution of one second, so the
+// size and, for manifests and mod.json, the SHA-256 of the file are compared
+// too; archives aren't hashed, as that would read the whole mod:
+//
+//   u32 magic, u32 version, u64 directory modification time, u32 mod count,
+//   then per mod: u64 modification time, u64 size, 32 byte SHA-256 (zeros
+//   when not hashed), encoded name, encoded metadata.
+//
+// The catalog lives in its own directory so that saving it doesn't change
+// the modification time of the mods directory.
+
+#define QMOD_CATALOG_MAGIC 0x54434D51 // "QMCT"
+#define QMOD_CATALOG_VERSION 2
+
+class QModCatalog {
+	struct Entry {
+		String name;
+		String title; // Lowercase, for filtering.
+		String type;
+		uint64_t modified_time = 0;
+		uint64_t size = 0;
+		String hash; // Empty for archives.
+		Dictionary info;
+
+		bool has_stamp_of(const Entry &p_other) const { return modified_time == p_other.modified_time && size == p_other.size && hash == p_other.hash; }
+	};
+
+	static inline QModCatalog *singleton = nullptr;
+
+	Mutex mutex;
+	bool loaded = false;
+	uint64_t directory_modified_time = 0;
+	LocalVector<Entry> entries; // Sorted by name.
+	HashMap<String, uint32_t> entry_indices;
+
+	// Rows of the last filtered query, so scrolling through the same results stays O(page size).
+	bool query_cached = false;
+	String query_type;
+	String query_title;
+	LocalVector<uint32_t> query_rows;
+
+	static uint64_t _get_directory_modified_time();
+	static bool _get_mod_stamp(const String &p_mod_name, Entry &r_entry);
+	static Error _store_variant(const Ref<FileAccess> &p_file, const Variant &p_value, Vector<uint8_t> &r_buffer);
+	static void _fill_entry(Entry &r_entry, const String &p_mod_name, const Dictionary &p_metadata);
+
+	Error _load();
+	Error _save();
+	void _rescan();
+	void _update();
+	void _rebuild_indices();
+	const LocalVector<uint32_t> *_get_rows(const String &p_type, const String &p_title);
+
+public:
+	static QModCatalog *get_singleton() { return singleton; }
+
+	static String get_catalog_path();
+
+	// Called after a mod was installed or uninstalled.
+	void set_mod(const String &p_mod_name, const Dictionary &p_metadata);
+	void remove_mod(const String &p_mod_name);
+
+	PackedStringArray get_mod_names();
+	bool has_mod(const String &p_mod_name);
+	Dictionary get_mod_info(const String &p_mod_name);
+
+	// An empty type or title matches every mod. Titles match case-insensitively as substrings.
+	int get_mod_count(const String &p_type = String(), const String &p_title = String());
+	Array query_mods(int p_offset, int p_count, const String &p_type = String(), const String &p_title = String());
+
+	QModCatalog();
+	~QModCatalog();
+};
@@ -2,11 +2,11 @@
 
 #ifdef TOOLS_ENABLED
 
+#include "qmod_exporter.h"
+#include "qmod_loader.h"
+
 #include "core/error/error_macros.h"
 #include "core/io/dir_access.h"
-#include "core/io/file_access.h"
-#include "core/io/json.h"
-#include "core/os/os.h"
 #include "editor/editor_data.h"
 #include "editor/gui/editor_file_dialog.h"
 #include "editor/editor_node.h"
@@ -45,8 +45,9 @@ void QModEditorPlugin::_open_scene_picker() {
 
 void QModEditorPlugin::_open_output_picker() {
         pending_dialog = FILE_DIALOG_OUTPUT;
-        file_dialog->set_file_mode(EditorFileDialog::FILE_MODE_OPEN_DIR);
+        file_dialog->set_file_mode(EditorFileDialog::FILE_MODE_SAVE_FILE);
         file_dialog->clear_filters();
+        file_dialog->add_filter("*.qmod", TTR("QMod Archives"));
         file_dialog->popup_file_dialog();
 }
 
@@ -67,71 +68,12 @@ void QModEditorPlugin::_dialog_file_selected(const String &p_path) {
 }
 
 void QModEditorPlugin::_import_file_selected(const String &p_path) {
-        String mods_dir = OS::get_singleton()->get_user_data_dir().path_join("mods");
-        DirAccess::create(mods_dir);
-
-        String target_dir = mods_dir.path_join(p_path.get_file());
-        Ref<DirAccess> dir = DirAccess::create_for_path(target_dir);
-        if (dir.is_valid() && dir->dir_exists(target_dir)) {
-                dir->remove_recursive(target_dir);
+        Ref<QModLoader> loader;
+        loader.instantiate();
+        Error err = loader->install_qmod(p_path);
+        if (err != OK) {
+                EditorNode::get_singleton()->show_warning(vformat(TTR("Failed to import QMod from \"%s\"."), p_path));
         }
-        _copy_dir(p_path, target_dir);
-}
-
-Error QModEditorPlugin::_copy_dir(const String &p_from, const String &p_to) {
-        Ref<DirAccess> src = DirAccess::create_for_path(p_from);
-        ERR_FAIL_COND_V(src.is_null(), ERR_CANT_OPEN);
-        Ref<DirAccess> dst = DirAccess::create_for_path(p_to);
-        ERR_FAIL_COND_V(dst.is_null(), ERR_CANT_CREATE);
-        dst->make_dir_recursive(".");
-
-        src->list_dir_begin();
-        String item;
-        while (!(item = src->get_next()).is_empty()) {
-                if (item == "." || item == "..") {
-                        continue;
-                }
-                const String src_path = p_from.path_join(item);
-                const String dst_path = p_to.path_join(item);
-                if (src->current_is_dir()) {
-                        Error err = _copy_dir(src_path, dst_path);
-                        if (err != OK) {
-                                src->list_dir_end();
-                                return err;
-                        }
-                } else {
-                        Error err = _copy_file(src_path, dst_path);
-                        if (err != OK) {
-                                src->list_dir_end();
-                                return err;
-                        }
-                }
-        }
-        src->list_dir_end();
-        return OK;
-}
-
-Error QModEditorPlugin::_copy_file(const String &p_from, const String &p_to) {
-        Ref<FileAccess> read = FileAccess::open(p_from, FileAccess::READ);
-        ERR_FAIL_COND_V(read.is_null(), ERR_CANT_OPEN);
-
-        Ref<FileAccess> write = FileAccess::open(p_to, FileAccess::WRITE);
-        ERR_FAIL_COND_V(write.is_null(), ERR_CANT_OPEN);
-
-        const uint64_t len = read->get_length();
-        Vector<uint8_t> buffer;
-        buffer.resize(len);
-        read->get_buffer(buffer.ptrw(), len);
-        write->store_buffer(buffer.ptr(), len);
-        return OK;
-}
-
-Error QModEditorPlugin::_write_json(const String &p_path, const Dictionary &p_dict) {
-        String json_text = JSON::stringify(p_dict, "\t");
-        Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
-        ERR_FAIL_COND_V(file.is_null(), ERR_CANT_CREATE);
-        file->store_string(json_text);
-        return OK;
 }
 
 String QModEditorPlugin::_resolve_mod_folder(const String &p_target) const {
@@ -155,30 +97,20 @@ void QModEditorPlugin::_confirm_export() {
 
         if (output_path.is_empty()) {
                 output_path = EditorPaths::get_singleton()->get_project_settings_dir().path_join("mods");
-                DirAccess::create(output_path);
+                DirAccess::make_dir_recursive_absolute(output_path);
                 output_path = output_path.path_join(title.is_empty() ? String("new_mod") : title);
         }
 
-        output_path = _resolve_mod_folder(output_path);
-
-        Ref<DirAccess> dir = DirAccess::create_for_path(output_path);
-        dir->make_dir_recursive(".");
-
-        Dictionary metadata;
-        metadata["title"] = title;
-        metadata["description"] = description;
-        metadata["icon"] = icon_path.get_file();
-        metadata["type"] = type_option->get_selected_id() == 0 ? "level" : "character";
-
-        String json_path = output_path.path_join("mod.json");
-        _write_json(json_path, metadata);
-
-        if (!icon_path.is_empty()) {
-                _copy_file(icon_path, output_path.path_join(icon_path.get_file()));
-        }
+        Ref<QModExporter> exporter;
+        exporter.instantiate();
+        exporter->set_title(title);
+        exporter->set_description(description);
+        exporter->set_icon_path(icon_path);
+        exporter->set_mod_type(type_option->get_selected_id() == 0 ? QModExporter::MOD_TYPE_LEVEL : QModExporter::MOD_TYPE_CHARACTER);
 
-        if (!scene_path.is_empty()) {
-                _copy_file(scene_path, output_path.path_join(scene_path.get_file()));
+        Error err = exporter->export_qmod(scene_path, _resolve_mod_folder(output_path));
+        if (err != OK) {
+                EditorNode::get_singleton()->show_warning(vformat(TTR("Failed to export QMod to \"%s\"."), output_path));
         }
 }
 
@@ -249,8 +181,10 @@ void QModEditorPlugin::_notification(int p_what) {
                 add_child(file_dialog);
 
                 import_dialog = memnew(EditorFileDialog);
-                import_dialog->set_file_mode(EditorFileDialog::FILE_MODE_OPEN_DIR);
+                import_dialog->set_file_mode(EditorFileDialog::FILE_MODE_OPEN_ANY);
+                import_dialog->add_filter("*.qmod", TTR("QMod Archives"));
                 import_dialog->connect(SceneStringName(file_selected), callable_mp(this, &QModEditorPlugin::_import_file_selected));
+                import_dialog->connect("dir_selected", callable_mp(this, &QModEditorPlugin::_import_file_selected));
                 add_child(import_dialog);
 
                 add_tool_menu_item(TTR("Export QMod"), callable_mp(this, &QModEditorPlugin::_open_export_dialog));
@@ -70,9 +70,6 @@ class QModEditorPlugin : public EditorPlugin {
         void _dialog_file_selected(const String &p_path);
         void _import_file_selected(const String &p_path);
         void _confirm_export();
-        Error _copy_dir(const String &p_from, const String &p_to);
-        Error _copy_file(const String &p_from, const String &p_to);
-        Error _write_json(const String &p_path, const Dictionary &p_dict);
         String _resolve_mod_folder(const String &p_target) const;
 
 public:
@@ -1,369 +1,315 @@
 /**************************************************************************/
-
 /*  qmod_exporter.cpp                                                     */
-
 /**************************************************************************/
-
 /*                         This file is part of:                          */
-
 /*                             GODOT ENGINE                               */
-
 /*                        https://godotengine.org                         */
-
 /**************************************************************************/
-
 /* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
-
 /* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
-
 /*                                                                        */
-
 /* Permission is hereby granted, free of charge, to any person obtaining  */
-
 /* a copy of this software and associated documentation files (the        */
-
 /* "Software"), to deal in the Software without restriction, including    */
-
 /* without limitation the rights to use, copy, modify, merge, publish,    */
-
 /* distribute, sublicense, and/or sell copies of the Software, and to     */
-
 /* permit persons to whom the Software is furnished to do so, subject to  */
-
 /* the following conditions:                                              */
-
 /*                                                                        */
-
 /* The above copyright notice and this permission notice shall be         */
-
 /* included in all copies or substantial portions of the Software.        */
-
 /*                                                                        */
-
 /* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
-
 /* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
-
 /* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
-
 /* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
-
 /* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
-
 /* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
-
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
-
 /**************************************************************************/
 
- 
-
 #include "qmod_exporter.h"
 
- 
+#include "qmod_archive.h"
 
 #include "core/io/dir_access.h"
-
 #include "core/io/file_access.h"
-
 #include "core/io/json.h"
-
- 
+#include "core/io/resource_importer.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_uid.h"
 
 void QModExporter::_bind_methods() {
-
 	ClassDB::bind_method(D_METHOD("set_title", "title"), &QModExporter::set_title);
-
 	ClassDB::bind_method(D_METHOD("get_title"), &QModExporter::get_title);
 
- 
-
 	ClassDB::bind_method(D_METHOD("set_description", "description"), &QModExporter::set_description);
-
 	ClassDB::bind_method(D_METHOD("get_description"), &QModExporter::get_description);
 
- 
-
 	ClassDB::bind_method(D_METHOD("set_icon_path", "icon_path"), &QModExporter::set_icon_path);
-
 	ClassDB::bind_method(D_METHOD("get_icon_path"), &QModExporter::get_icon_path);
 
- 
-
 	ClassDB::bind_method(D_METHOD("set_mod_type", "type"), &QModExporter::set_mod_type);
-
 	ClassDB::bind_method(D_METHOD("get_mod_type"), &QModExporter::get_mod_type);
 
- 
+	ClassDB::bind_method(D_METHOD("set_compress", "compress"), &QModExporter::set_compress);
+	ClassDB::bind_method(D_METHOD("is_compress"), &QModExporter::is_compress);
 
 	ClassDB::bind_method(D_METHOD("export_qmod", "scene_path", "output_path"), &QModExporter::export_qmod);
 
- 
-
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "title"), "set_title", "get_title");
-
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "description", PROPERTY_HINT_MULTILINE_TEXT), "set_description", "get_description");
-
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "icon_path", PROPERTY_HINT_FILE, "*.png,*.jpg,*.svg"), "set_icon_path", "get_icon_path");
-
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "mod_type", PROPERTY_HINT_ENUM, "Level,Character"), "set_mod_type", "get_mod_type");
-
- 
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compress"), "set_compress", "is_compress");
 
 	BIND_ENUM_CONSTANT(MOD_TYPE_LEVEL);
-
 	BIND_ENUM_CONSTANT(MOD_TYPE_CHARACTER);
-
 }
 
- 
-
 void QModExporter::set_title(const String &p_title) {
-
 	title = p_title;
-
 }
 
- 
-
 String QModExporter::get_title() const {
-
 	return title;
-
 }
 
- 
-
 void QModExporter::set_description(const String &p_description) {
-
 	description = p_description;
-
 }
 
- 
-
 String QModExporter::get_description() const {
-
 	return description;
-
 }
 
- 
-
 void QModExporter::set_icon_path(const String &p_icon_path) {
-
 	icon_path = p_icon_path;
-
 }
 
- 
-
 String QModExporter::get_icon_path() const {
-
 	return icon_path;
-
 }
 
- 
-
 void QModExporter::set_mod_type(ModType p_type) {
-
 	mod_type = p_type;
-
 }
 
- 
-
 QModExporter::ModType QModExporter::get_mod_type() const {
-
 	return mod_type;
-
 }
 
- 
-
-Error QModExporter::_copy_file(const String &p_from, const String &p_to) {
-
-	Ref<FileAccess> read = FileAccess::open(p_from, FileAccess::READ);
-
-	if (read.is_null()) {
+void QModExporter::set_compress(bool p_compress) {
+	compress = p_compress;
+}
 
-		ERR_PRINT("Could not open source file: " + p_from);
+bool QModExporter::is_compress() const {
+	return compress;
+}
 
-		return ERR_FILE_CANT_READ;
+String QModExporter::_get_archive_path(const String &p_path) {
+	// Project files keep their place in the project, anything else goes to the root.
+	return p_path.begins_with("res://") ? p_path.trim_prefix("res://") : p_path.get_file();
+}
 
+String QModExporter::_get_dependency_path(const String &p_dependency) {
+	// Entries are "path", or "uid::type::fallback path".
+	String path = p_dependency.get_slice("::", 0);
+	if (path.begins_with("uid://")) {
+		path = ResourceUID::ensure_path(path);
+		if (path.is_empty() || path.begins_with("uid://")) {
+			path = p_dependency.get_slice("::", 2);
+		}
 	}
+	return path;
+}
 
- 
-
-	Ref<FileAccess> write = FileAccess::open(p_to, FileAccess::WRITE);
-
-	if (write.is_null()) {
-
-		ERR_PRINT("Could not create destination file: " + p_to);
-
-		return ERR_FILE_CANT_WRITE;
-
+void QModExporter::_collect_files(const String &p_path, HashSet<String> &r_visited, LocalVector<String> &r_files) {
+	if (r_visited.has(p_path)) {
+		return;
 	}
+	r_visited.insert(p_path);
 
- 
-
-	uint64_t len = read->get_length();
-
-	Vector<uint8_t> buffer;
-
-	buffer.resize(len);
+	if (!FileAccess::exists(p_path)) {
+		WARN_PRINT("QMOD export: Skipping missing dependency: " + p_path);
+		return;
+	}
+	r_files.push_back(p_path);
+
+	// Imported assets are loaded from their import metadata and the files it points to.
+	String import_path = p_path + ".import";
+	if (FileAccess::exists(import_path)) {
+		r_visited.insert(import_path);
+		r_files.push_back(import_path);
+
+		// Every variant (e.g. per texture compression format), the runtime picks the one it supports.
+		List<String> internal_paths;
+		ResourceFormatImporter::get_singleton()->get_internal_resource_path_list(p_path, &internal_paths);
+		for (const String &internal_path : internal_paths) {
+			if (!r_visited.has(internal_path) && FileAccess::exists(internal_path)) {
+				r_visited.insert(internal_path);
+				r_files.push_back(internal_path);
+			}
+		}
+	}
 
-	read->get_buffer(buffer.ptrw(), len);
+	List<String> dependencies;
+	ResourceLoader::get_dependencies(p_path, &dependencies);
+	for (const String &dependency : dependencies) {
+		String path = _get_dependency_path(dependency);
+		if (path.is_empty()) {
+			continue;
+		}
+		if (!path.begins_with("res://")) {
+			WARN_PRINT("QMOD export: Skipping dependency outside the project: " + path);
+			continue;
+		}
+		_collect_files(path, r_visited, r_files);
+	}
+}
 
-	write->store_buffer(buffer.ptr(), len);
+String QModExporter::_get_remapped_import_file(const String &p_import_path, const HashSet<String> &p_exported) {
+	// "path" and "path.<feature>" point into the project's .godot folder, use the copies shipped with the mod instead.
+	String base_dir = p_import_path.get_base_dir();
+	Vector<String> lines = FileAccess::get_file_as_string(p_import_path).split("\n");
+	for (int i = 0; i < lines.size(); i++) {
+		const String &line = lines[i];
+		int begin = line.find_char('"');
+		int end = line.rfind_char('"');
+		if (!line.begins_with("path") || begin < 0 || end <= begin) {
+			continue;
+		}
+		String path = line.substr(begin + 1, end - begin - 1);
+		if (p_exported.has(path)) {
+			lines.write[i] = line.substr(0, begin + 1) + base_dir.path_to_file(path) + line.substr(end);
+		}
+	}
+	return String("\n").join(lines);
+}
 
- 
+Error QModExporter::_add_file(QModArchiveWriter &p_writer, const String &p_path, const HashSet<String> &p_exported, const String &p_staging_path) {
+	String archive_path = _get_archive_path(p_path);
+	if (p_path.ends_with(".import")) {
+		CharString text = _get_remapped_import_file(p_path, p_exported).utf8();
+		return p_writer.add_buffer(archive_path, (const uint8_t *)text.get_data(), text.length());
+	}
 
-	return OK;
+	// Mods are mounted below their own directory, not at res://, so references to other exported files are made
+	// relative. This also drops their UIDs, which would resolve to the host project's files instead.
+	HashMap<String, String> remaps;
+	if (p_path.begins_with("res://") && !p_exported.has(p_path + ".import")) {
+		List<String> dependencies;
+		ResourceLoader::get_dependencies(p_path, &dependencies);
+		for (const String &dependency : dependencies) {
+			String path = _get_dependency_path(dependency);
+			if (path.begins_with("res://") && p_exported.has(path)) {
+				remaps[path] = p_path.get_base_dir().path_to_file(path);
+			}
+		}
+	}
+	if (remaps.is_empty()) {
+		return p_writer.add_file(archive_path, p_path, compress);
+	}
 
+	// The loaders rewrite dependencies in place, so work on a copy that keeps the extension they recognize.
+	String staged_path = p_staging_path + "." + p_path.get_extension();
+	Error err = DirAccess::copy_absolute(p_path, staged_path);
+	if (err == OK) {
+		err = ResourceLoader::rename_dependencies(staged_path, remaps);
+	}
+	if (err == OK) {
+		err = p_writer.add_file(archive_path, staged_path, compress);
+	}
+	DirAccess::remove_absolute(staged_path);
+	return err;
 }
 
- 
-
 Error QModExporter::export_qmod(const String &p_scene_path, const String &p_output_path) {
-
 	// Validate inputs
-
 	if (title.is_empty()) {
-
 		ERR_PRINT("QMOD export failed: Title cannot be empty");
-
 		return ERR_INVALID_PARAMETER;
-
 	}
 
- 
-
 	if (!FileAccess::exists(p_scene_path)) {
-
 		ERR_PRINT("QMOD export failed: Scene file does not exist: " + p_scene_path);
-
 		return ERR_FILE_NOT_FOUND;
-
 	}
 
- 
-
 	// Ensure output path ends with .qmod
-
-	String output_dir = p_output_path;
-
-	if (!output_dir.ends_with(".qmod")) {
-
-		output_dir += ".qmod";
-
+	String output_path = p_output_path;
+	if (!output_path.ends_with(".qmod")) {
+		output_path += ".qmod";
 	}
 
- 
-
 	// Create output directory
-
-	Ref<DirAccess> dir = DirAccess::create_for_path(output_dir);
-
-	Error err = dir->make_dir_recursive(".");
-
+	Error err = DirAccess::make_dir_recursive_absolute(output_path.get_base_dir());
 	if (err != OK) {
-
-		ERR_PRINT("QMOD export failed: Could not create output directory: " + output_dir);
-
+		ERR_PRINT("QMOD export failed: Could not create output directory: " + output_path.get_base_dir());
 		return err;
-
 	}
 
- 
+	// Everything the scene (and the icon) needs to load, mod.json aside.
+	HashSet<String> visited;
+	LocalVector<String> files;
+	_collect_files(p_scene_path, visited, files);
+	bool has_icon = !icon_path.is_empty() && FileAccess::exists(icon_path);
+	if (has_icon) {
+		_collect_files(icon_path, visited, files);
+	}
 
 	// Create metadata dictionary
-
 	Dictionary metadata;
-
 	metadata["title"] = title;
-
 	metadata["description"] = description;
-
-	metadata["icon"] = icon_path.get_file();
-
+	metadata["icon"] = has_icon ? _get_archive_path(icon_path) : icon_path.get_file();
 	metadata["type"] = mod_type == MOD_TYPE_LEVEL ? "level" : "character";
+	metadata["scene"] = _get_archive_path(p_scene_path);
 
-	metadata["scene"] = p_scene_path.get_file();
-
- 
-
-	// Write mod.json
-
-	String json_text = JSON::stringify(metadata, "\t");
-
-	String json_path = output_dir.path_join("mod.json");
-
-	Ref<FileAccess> json_file = FileAccess::open(json_path, FileAccess::WRITE);
-
-	if (json_file.is_null()) {
-
-		ERR_PRINT("QMOD export failed: Could not write mod.json");
-
-		return ERR_FILE_CANT_WRITE;
-
+	QModArchiveWriter writer;
+	err = writer.open(output_path);
+	if (err != OK) {
+		ERR_PRINT("QMOD export failed: Could not create archive: " + output_path);
+		return err;
 	}
 
-	json_file->store_string(json_text);
-
- 
-
-	// Copy scene file
-
-	String scene_dest = output_dir.path_join(p_scene_path.get_file());
-
-	err = _copy_file(p_scene_path, scene_dest);
-
+	// Write mod.json
+	CharString json_text = JSON::stringify(metadata, "\t").utf8();
+	err = writer.add_buffer("mod.json", (const uint8_t *)json_text.get_data(), json_text.length());
 	if (err != OK) {
-
-		ERR_PRINT("QMOD export failed: Could not copy scene file");
-
+		ERR_PRINT("QMOD export failed: Could not write mod.json");
 		return err;
-
 	}
 
- 
-
-	// Copy icon if specified
-
-	if (!icon_path.is_empty() && FileAccess::exists(icon_path)) {
-
-		String icon_dest = output_dir.path_join(icon_path.get_file());
-
-		err = _copy_file(icon_path, icon_dest);
+	HashSet<String> exported;
+	for (const String &file : files) {
+		exported.insert(file);
+	}
 
+	// Files are streamed into the archive, so their size doesn't matter.
+	String staging_path = output_path + ".staging";
+	for (const String &file : files) {
+		err = _add_file(writer, file, exported, staging_path);
 		if (err != OK) {
-
-			WARN_PRINT("Could not copy icon file, continuing anyway");
-
+			ERR_PRINT("QMOD export failed: Could not add file: " + file);
+			return err;
 		}
-
 	}
 
- 
-
-	print_line("QMOD exported successfully to: " + output_dir);
+	err = writer.finish();
+	if (err != OK) {
+		ERR_PRINT("QMOD export failed: Could not finalize archive: " + output_path);
+		return err;
+	}
 
+	print_line(vformat("QMOD exported successfully to: %s (%d files)", output_path, files.size() + 1));
 	return OK;
-
 }
 
- 
-
 QModExporter::QModExporter() {
-
 	title = "My Mod";
-
 	description = "";
-
 	icon_path = "";
-
 	mod_type = MOD_TYPE_LEVEL;
-
+	compress = true;
 }
@@ -33,6 +33,10 @@
 
 #include "core/io/resource_saver.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+class QModArchiveWriter;
 
 class QModExporter : public RefCounted {
 	GDCLASS(QModExporter, RefCounted);
@@ -44,12 +48,17 @@ public:
 	};
 
 private:
-        String title;
-        String description;
-        String icon_path;
-        ModType mod_type = MOD_TYPE_LEVEL;
+	String title;
+	String description;
+	String icon_path;
+	ModType mod_type = MOD_TYPE_LEVEL;
+	bool compress = true;
 
-        Error _copy_file(const String &p_from, const String &p_to);
+	static String _get_archive_path(const String &p_path);
+	static String _get_dependency_path(const String &p_dependency);
+	static void _collect_files(const String &p_path, HashSet<String> &r_visited, LocalVector<String> &r_files);
+	static String _get_remapped_import_file(const String &p_import_path, const HashSet<String> &p_exported);
+	Error _add_file(QModArchiveWriter &p_writer, const String &p_path, const HashSet<String> &p_exported, const String &p_staging_path);
 
 protected:
 	static void _bind_methods();
@@ -67,6 +76,9 @@ public:
 	void set_mod_type(ModType p_type);
 	ModType get_mod_type() const;
 
+	void set_compress(bool p_compress);
+	bool is_compress() const;
+
 	Error export_qmod(const String &p_scene_path, const String &p_output_path);
 
 	QModExporter();
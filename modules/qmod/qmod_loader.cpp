@@ -1,613 +1,542 @@
 /**************************************************************************/
-
 /*  qmod_loader.cpp                                                       */
-
 /**************************************************************************/
-
 /*                         This file is part of:                          */
-
 /*                             GODOT ENGINE                               */
-
 /*                        https://godotengine.org                         */
-
 /**************************************************************************/
-
 /* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
-
 /* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
-
 /*                                                                        */
-
 /* Permission is hereby granted, free of charge, to any person obtaining  */
-
 /* a copy of this software and associated documentation files (the        */
-
 /* "Software"), to deal in the Software without restriction, including    */
-
 /* without limitation the rights to use, copy, modify, merge, publish,    */
-
 /* distribute, sublicense, and/or sell copies of the Software, and to     */
-
 /* permit persons to whom the Software is furnished to do so, subject to  */
-
 /* the following conditions:                                              */
-
 /*                                                                        */
-
 /* The above copyright notice and this permission notice shall be         */
-
 /* included in all copies or substantial portions of the Software.        */
-
 /*                                                                        */
-
 /* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
-
 /* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
-
 /* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
-
 /* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
-
 /* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
-
 /* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
-
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
-
 /**************************************************************************/
 
- 
-
 #include "qmod_loader.h"
 
- 
+#include "file_access_qmod.h"
+#include "qmod_archive.h"
+#include "qmod_catalog.h"
+#include "qmod_store.h"
 
 #include "core/io/dir_access.h"
-
 #include "core/io/file_access.h"
-
 #include "core/io/json.h"
-
 #include "core/io/resource_loader.h"
-
 #include "scene/resources/packed_scene.h"
 
- 
-
 void QModLoader::_bind_methods() {
-
 	ClassDB::bind_method(D_METHOD("install_qmod", "qmod_path"), &QModLoader::install_qmod);
-
 	ClassDB::bind_method(D_METHOD("uninstall_qmod", "mod_name"), &QModLoader::uninstall_qmod);
-
 	ClassDB::bind_method(D_METHOD("get_installed_mods"), &QModLoader::get_installed_mods);
-
 	ClassDB::bind_method(D_METHOD("get_mod_info", "mod_name"), &QModLoader::get_mod_info);
-
+	ClassDB::bind_method(D_METHOD("get_mod_count", "type", "title"), &QModLoader::get_mod_count, DEFVAL(String()), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("query_mods", "offset", "count", "type", "title"), &QModLoader::query_mods, DEFVAL(String()), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("load_mod_scene", "mod_name"), &QModLoader::load_mod_scene);
-
+	ClassDB::bind_method(D_METHOD("request_mod_scene", "mod_name"), &QModLoader::request_mod_scene);
+	ClassDB::bind_method(D_METHOD("request_mod_scenes", "mod_names"), &QModLoader::request_mod_scenes);
+	ClassDB::bind_method(D_METHOD("get_mod_scene_status", "mod_name", "progress"), &QModLoader::get_mod_scene_status, DEFVAL_ARRAY);
+	ClassDB::bind_method(D_METHOD("get_mod_scene", "mod_name"), &QModLoader::get_mod_scene);
 	ClassDB::bind_static_method("QModLoader", D_METHOD("get_mods_directory"), &QModLoader::get_mods_directory);
 
+	BIND_ENUM_CONSTANT(SCENE_LOAD_INVALID);
+	BIND_ENUM_CONSTANT(SCENE_LOAD_IN_PROGRESS);
+	BIND_ENUM_CONSTANT(SCENE_LOAD_FAILED);
+	BIND_ENUM_CONSTANT(SCENE_LOAD_LOADED);
 }
 
- 
-
 String QModLoader::get_mods_directory() {
-
 	return "user://mods";
-
 }
 
- 
-
-Error QModLoader::_copy_dir(const String &p_from, const String &p_to) {
-
-	Ref<DirAccess> src = DirAccess::open(p_from);
-
-	if (src.is_null()) {
-
-		ERR_PRINT("Could not open source directory: " + p_from);
-
-		return ERR_FILE_CANT_READ;
+String QModLoader::_get_archive_path(const String &p_mod_name) {
+	return get_mods_directory() + "/" + p_mod_name + ".qmod";
+}
 
+Error QModLoader::_parse_metadata(const String &p_json, Dictionary &r_metadata) {
+	JSON json;
+	Error err = json.parse(p_json);
+	if (err != OK) {
+		return err;
 	}
+	r_metadata = json.get_data();
+	return OK;
+}
 
- 
-
-	Ref<DirAccess> dst = DirAccess::create_for_path(p_to);
+Error QModLoader::_mount_mod(const String &p_mod_name) {
+	String mount_path = QModStore::get_manifest_path(p_mod_name);
+	bool is_manifest = FileAccess::exists(mount_path);
+	if (!is_manifest) {
+		mount_path = _get_archive_path(p_mod_name);
+		if (!FileAccess::exists(mount_path)) {
+			// Legacy mods are extracted into a plain directory, nothing to mount.
+			return OK;
+		}
+	}
 
-	Error err = dst->make_dir_recursive(".");
+	PackSourceQMod *source = PackSourceQMod::get_singleton();
+	ERR_FAIL_NULL_V_MSG(source, ERR_UNAVAILABLE, "Mods can't be mounted, the pack file system is not available.");
+	if (source->is_mounted(mount_path)) {
+		return OK;
+	}
 
+	String mount_point = get_mods_directory() + "/" + p_mod_name;
+	Error err = is_manifest ? source->mount_manifest(mount_path, mount_point, true) : source->mount(mount_path, mount_point, true);
 	if (err != OK) {
+		ERR_PRINT("Could not mount mod: " + mount_path);
+	}
+	return err;
+}
 
-		ERR_PRINT("Could not create destination directory: " + p_to);
-
+Error QModLoader::_read_metadata(const String &p_mod_name, Dictionary &r_metadata) {
+	Error err = _mount_mod(p_mod_name);
+	if (err != OK) {
 		return err;
-
 	}
 
- 
+	String json_path = get_mods_directory() + "/" + p_mod_name + "/mod.json";
 
-	src->list_dir_begin();
+	Ref<FileAccess> file = FileAccess::open(json_path, FileAccess::READ);
+	if (file.is_null()) {
+		ERR_PRINT("Could not read mod.json for: " + p_mod_name);
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	err = _parse_metadata(file->get_as_text(), r_metadata);
+	if (err != OK) {
+		ERR_PRINT("Could not parse mod.json for: " + p_mod_name);
+	}
+	return err;
+}
 
-	String file_name = src->get_next();
+void QModLoader::_list_dir_files(const String &p_dir, const String &p_relative, LocalVector<String> &r_files) {
+	Ref<DirAccess> dir = DirAccess::open(p_dir.path_join(p_relative));
+	if (dir.is_null()) {
+		return;
+	}
 
+	dir->list_dir_begin();
+	String file_name = dir->get_next();
 	while (!file_name.is_empty()) {
-
 		if (file_name != "." && file_name != "..") {
-
-			String src_path = p_from.path_join(file_name);
-
-			String dst_path = p_to.path_join(file_name);
-
- 
-
-			if (src->current_is_dir()) {
-
-				err = _copy_dir(src_path, dst_path);
-
-				if (err != OK) {
-
-					src->list_dir_end();
-
-					return err;
-
-				}
-
+			String relative = p_relative.path_join(file_name);
+			if (dir->current_is_dir()) {
+				_list_dir_files(p_dir, relative, r_files);
 			} else {
-
-				err = _copy_file(src_path, dst_path);
-
-				if (err != OK) {
-
-					src->list_dir_end();
-
-					return err;
-
-				}
-
+				r_files.push_back(relative);
 			}
-
 		}
-
-		file_name = src->get_next();
-
-	}
-
-	src->list_dir_end();
-
- 
-
-	return OK;
-
-}
-
- 
-
-Error QModLoader::_copy_file(const String &p_from, const String &p_to) {
-
-	Ref<FileAccess> read = FileAccess::open(p_from, FileAccess::READ);
-
-	if (read.is_null()) {
-
-		ERR_PRINT("Could not open source file: " + p_from);
-
-		return ERR_FILE_CANT_READ;
-
-	}
-
- 
-
-	Ref<FileAccess> write = FileAccess::open(p_to, FileAccess::WRITE);
-
-	if (write.is_null()) {
-
-		ERR_PRINT("Could not create destination file: " + p_to);
-
-		return ERR_FILE_CANT_WRITE;
-
+		file_name = dir->get_next();
 	}
-
- 
-
-	uint64_t len = read->get_length();
-
-	Vector<uint8_t> buffer;
-
-	buffer.resize(len);
-
-	read->get_buffer(buffer.ptrw(), len);
-
-	write->store_buffer(buffer.ptr(), len);
-
- 
-
-	return OK;
-
+	dir->list_dir_end();
 }
 
- 
-
 Error QModLoader::install_qmod(const String &p_qmod_path) {
-
-	Ref<DirAccess> qmod_dir = DirAccess::open(p_qmod_path);
-
-	if (qmod_dir.is_null()) {
-
-		ERR_PRINT("QMOD installation failed: Directory does not exist: " + p_qmod_path);
-
-		return ERR_FILE_NOT_FOUND;
-
-	}
-
- 
-
-	// Read mod.json to get mod name
-
-	String json_path = p_qmod_path.path_join("mod.json");
-
-	if (!FileAccess::exists(json_path)) {
-
-		ERR_PRINT("QMOD installation failed: mod.json not found in: " + p_qmod_path);
-
-		return ERR_FILE_NOT_FOUND;
-
+	// Mods exported before the single-file format are plain directories.
+	bool is_dir = DirAccess::dir_exists_absolute(p_qmod_path);
+
+	Ref<QModArchive> archive;
+	LocalVector<String> dir_files;
+	String json_string;
+	Error err = OK;
+	if (is_dir) {
+		String json_path = p_qmod_path.path_join("mod.json");
+		if (!FileAccess::exists(json_path)) {
+			ERR_PRINT("QMOD installation failed: mod.json not found in: " + p_qmod_path);
+			return ERR_FILE_NOT_FOUND;
+		}
+		json_string = FileAccess::get_file_as_string(json_path, &err);
+		_list_dir_files(p_qmod_path, "", dir_files);
+	} else {
+		archive.instantiate();
+		err = archive->open(p_qmod_path);
+		if (err != OK) {
+			ERR_PRINT("QMOD installation failed: Could not open archive: " + p_qmod_path);
+			return err;
+		}
+		json_string = archive->get_file_as_string("mod.json", &err);
 	}
-
- 
-
-	Ref<FileAccess> json_file = FileAccess::open(json_path, FileAccess::READ);
-
-	if (json_file.is_null()) {
-
-		ERR_PRINT("QMOD installation failed: Could not read mod.json");
-
-		return ERR_FILE_CANT_READ;
-
+	if (err != OK) {
+		ERR_PRINT("QMOD installation failed: Could not read mod.json from: " + p_qmod_path);
+		return err;
 	}
 
- 
-
-	String json_string = json_file->get_as_text();
-
- 
-
-	JSON json;
-
-	Error err = json.parse(json_string);
-
+	Dictionary metadata;
+	err = _parse_metadata(json_string, metadata);
 	if (err != OK) {
-
 		ERR_PRINT("QMOD installation failed: Could not parse mod.json");
-
 		return err;
-
 	}
 
- 
-
-	Dictionary metadata = json.get_data();
-
 	if (!metadata.has("title")) {
-
 		ERR_PRINT("QMOD installation failed: mod.json missing 'title' field");
-
 		return ERR_INVALID_DATA;
-
 	}
 
- 
-
 	String mod_name = String(metadata["title"]).replace(" ", "_").to_lower();
 
- 
-
 	// Create mods directory if it doesn't exist
-
 	String mods_dir = get_mods_directory();
-
 	Ref<DirAccess> dir = DirAccess::open("user://");
-
 	if (!dir->dir_exists("mods")) {
-
 		dir->make_dir("mods");
-
 	}
 
- 
-
-	// Create mod directory
-
-	String mod_dir = mods_dir + "/" + mod_name;
-
- 
+	// Files whose hash didn't change since the installed version are skipped outright.
+	String manifest_path = QModStore::get_manifest_path(mod_name);
+	QModManifest old_manifest;
+	HashMap<String, String> old_hashes;
+	if (FileAccess::exists(manifest_path) && old_manifest.load(manifest_path) == OK) {
+		print_line("QMOD installation: Updating existing mod: " + mod_name);
+		for (const QModManifest::Entry &entry : old_manifest.entries) {
+			old_hashes[entry.path] = entry.hash;
+		}
+	}
 
-	// Check if mod already exists
+	QModManifest manifest;
+	HashSet<String> written_blobs;
+	uint32_t unchanged = 0;
+	uint64_t written_bytes = 0;
+
+	uint32_t file_count = is_dir ? dir_files.size() : archive->get_file_count();
+	manifest.entries.resize(file_count);
+	for (uint32_t i = 0; i < file_count; i++) {
+		QModManifest::Entry &entry = manifest.entries[i];
+
+		Vector<uint8_t> buffer;
+		const uint8_t *data = nullptr;
+		if (is_dir) {
+			entry.path = dir_files[i];
+			buffer = FileAccess::get_file_as_bytes(p_qmod_path.path_join(entry.path), &err);
+			if (err != OK) {
+				break;
+			}
+			data = buffer.ptr();
+			entry.size = buffer.size();
+		} else {
+			entry.path = archive->get_file_path(i);
+			entry.size = archive->get_file_size(i);
+			if (archive->is_file_compressed(i)) {
+				buffer.resize(entry.size);
+				err = archive->read_file(i, buffer.ptrw());
+				if (err != OK) {
+					break;
+				}
+				data = buffer.ptr();
+			} else {
+				// Hashed and stored straight from the archive mapping.
+				data = archive->get_file_data(i);
+			}
+		}
 
-	if (DirAccess::exists(mod_dir)) {
+		// Archives were validated when opened, loose directories go through the same check.
+		if (!QModArchive::is_valid_entry_path(entry.path)) {
+			ERR_PRINT(vformat("QMOD installation: Invalid file path in mod: '%s'.", entry.path));
+			err = ERR_FILE_CORRUPT;
+			break;
+		}
 
-		print_line("QMOD installation: Mod already exists, overwriting: " + mod_name);
+		entry.hash = QModStore::hash_buffer(data, entry.size);
 
-		// Could delete old version here if needed
+		HashMap<String, String>::ConstIterator E = old_hashes.find(entry.path);
+		if (E && E->value == entry.hash) {
+			unchanged++;
+			continue;
+		}
 
+		bool written = false;
+		err = QModStore::store_blob(entry.hash, data, entry.size, written);
+		if (err != OK) {
+			break;
+		}
+		if (written) {
+			written_blobs.insert(entry.hash);
+			written_bytes += entry.size;
+		}
 	}
 
- 
-
-	// Copy the entire qmod directory to the mods folder
-
-	err = _copy_dir(p_qmod_path, mod_dir);
-
+	if (err == OK) {
+		err = manifest.save(manifest_path);
+	}
 	if (err != OK) {
-
-		ERR_PRINT("QMOD installation failed: Could not copy mod files");
-
+		// Nothing references the new blobs yet.
+		QModStore::release_blobs(written_blobs);
+		ERR_PRINT("QMOD installation failed: Could not store mod files");
 		return err;
+	}
 
+	// Drop copies installed by older versions so they can't shadow the manifest.
+	String mod_dir = mods_dir + "/" + mod_name;
+	String archive_path = _get_archive_path(mod_name);
+	PackSourceQMod *source = PackSourceQMod::get_singleton();
+	bool was_mounted = source && (source->is_mounted(manifest_path) || source->is_mounted(archive_path));
+	if (source) {
+		source->unmount(archive_path);
+		source->unmount(manifest_path);
+	}
+	if (FileAccess::exists(archive_path)) {
+		DirAccess::remove_absolute(archive_path);
+	}
+	if (DirAccess::exists(mod_dir)) {
+		_remove_dir_recursive(mod_dir);
+	}
+	if (was_mounted) {
+		_mount_mod(mod_name);
 	}
 
- 
+	// Blobs only the previous version used are no longer needed.
+	HashSet<String> stale_blobs;
+	old_manifest.get_hashes(stale_blobs);
+	for (const QModManifest::Entry &entry : manifest.entries) {
+		stale_blobs.erase(entry.hash);
+	}
+	QModStore::release_blobs(stale_blobs);
 
-	print_line("QMOD installed successfully: " + mod_name + " to " + mod_dir);
+	if (QModCatalog::get_singleton()) {
+		QModCatalog::get_singleton()->set_mod(mod_name, metadata);
+	}
 
+	print_line(vformat("QMOD installed successfully: %s (%d files, %d unchanged, %d new blobs, %s written)", mod_name, file_count, unchanged, written_blobs.size(), String::humanize_size(written_bytes)));
 	return OK;
-
 }
 
- 
-
 Error QModLoader::uninstall_qmod(const String &p_mod_name) {
-
 	String mod_dir = get_mods_directory() + "/" + p_mod_name;
+	String archive_path = _get_archive_path(p_mod_name);
+	String manifest_path = QModStore::get_manifest_path(p_mod_name);
 
-	Ref<DirAccess> dir = DirAccess::open(mod_dir);
-
- 
-
-	if (dir.is_null()) {
-
-		ERR_PRINT("QMOD uninstall failed: Mod not found: " + p_mod_name);
+	bool found = false;
+	if (FileAccess::exists(manifest_path)) {
+		if (PackSourceQMod::get_singleton()) {
+			PackSourceQMod::get_singleton()->unmount(manifest_path);
+		}
 
-		return ERR_FILE_NOT_FOUND;
+		QModManifest manifest;
+		HashSet<String> blobs;
+		if (manifest.load(manifest_path) == OK) {
+			manifest.get_hashes(blobs);
+		}
 
+		Error err = DirAccess::remove_absolute(manifest_path);
+		if (err != OK) {
+			ERR_PRINT("QMOD uninstall failed: Could not remove mod manifest");
+			return err;
+		}
+		QModStore::release_blobs(blobs);
+		found = true;
 	}
 
- 
-
-	// Remove all files in the mod directory recursively
-
-	Error err = _remove_dir_recursive(mod_dir);
-
-	if (err != OK) {
+	if (FileAccess::exists(archive_path)) {
+		if (PackSourceQMod::get_singleton()) {
+			PackSourceQMod::get_singleton()->unmount(archive_path);
+		}
 
-		ERR_PRINT("QMOD uninstall failed: Could not remove mod directory");
+		Error err = DirAccess::remove_absolute(archive_path);
+		if (err != OK) {
+			ERR_PRINT("QMOD uninstall failed: Could not remove mod archive");
+			return err;
+		}
+		found = true;
+	}
 
-		return err;
+	if (DirAccess::exists(mod_dir)) {
+		// Remove all files in the mod directory recursively
+		Error err = _remove_dir_recursive(mod_dir);
+		if (err != OK) {
+			ERR_PRINT("QMOD uninstall failed: Could not remove mod directory");
+			return err;
+		}
+		found = true;
+	}
 
+	if (!found) {
+		ERR_PRINT("QMOD uninstall failed: Mod not found: " + p_mod_name);
+		return ERR_FILE_NOT_FOUND;
 	}
 
- 
+	if (QModCatalog::get_singleton()) {
+		QModCatalog::get_singleton()->remove_mod(p_mod_name);
+	}
 
 	print_line("QMOD uninstalled successfully: " + p_mod_name);
-
 	return OK;
-
 }
 
- 
-
 Error QModLoader::_remove_dir_recursive(const String &p_dir) {
-
 	Ref<DirAccess> dir = DirAccess::open(p_dir);
-
 	if (dir.is_null()) {
-
 		return ERR_FILE_NOT_FOUND;
-
 	}
 
- 
-
 	dir->list_dir_begin();
-
 	String file_name = dir->get_next();
-
 	while (!file_name.is_empty()) {
-
 		if (file_name != "." && file_name != "..") {
-
 			String path = p_dir.path_join(file_name);
-
 			if (dir->current_is_dir()) {
-
 				Error err = _remove_dir_recursive(path);
-
 				if (err != OK) {
-
 					dir->list_dir_end();
-
 					return err;
-
 				}
-
 			} else {
-
 				Error err = dir->remove(file_name);
-
 				if (err != OK) {
-
 					dir->list_dir_end();
-
 					return err;
-
 				}
-
 			}
-
 		}
-
 		file_name = dir->get_next();
-
 	}
-
 	dir->list_dir_end();
 
- 
-
 	// Remove the directory itself
-
 	Ref<DirAccess> parent_dir = DirAccess::open(p_dir.get_base_dir());
-
 	return parent_dir->remove(p_dir.get_file());
-
 }
 
- 
-
 Array QModLoader::get_installed_mods() {
-
+	ERR_FAIL_NULL_V(QModCatalog::get_singleton(), Array());
 	Array mods;
-
-	String mods_dir = get_mods_directory();
-
- 
-
-	Ref<DirAccess> dir = DirAccess::open(mods_dir);
-
-	if (dir.is_null()) {
-
-		return mods;
-
+	for (const String &mod_name : QModCatalog::get_singleton()->get_mod_names()) {
+		mods.append(mod_name);
 	}
-
- 
-
-	dir->list_dir_begin();
-
-	String dir_name = dir->get_next();
-
-	while (!dir_name.is_empty()) {
-
-		if (dir->current_is_dir() && !dir_name.begins_with(".")) {
-
-			mods.append(dir_name);
-
-		}
-
-		dir_name = dir->get_next();
-
-	}
-
-	dir->list_dir_end();
-
- 
-
 	return mods;
-
 }
 
- 
-
 Dictionary QModLoader::get_mod_info(const String &p_mod_name) {
-
-	Dictionary info;
-
-	String json_path = get_mods_directory() + "/" + p_mod_name + "/mod.json";
-
- 
-
-	Ref<FileAccess> file = FileAccess::open(json_path, FileAccess::READ);
-
-	if (file.is_null()) {
-
-		ERR_PRINT("Could not read mod.json for: " + p_mod_name);
-
-		return info;
-
-	}
-
- 
-
-	String json_string = file->get_as_text();
-
- 
-
-	JSON json;
-
-	Error err = json.parse(json_string);
-
-	if (err != OK) {
-
-		ERR_PRINT("Could not parse mod.json for: " + p_mod_name);
-
-		return info;
-
-	}
-
- 
-
-	info = json.get_data();
-
-	info["mod_directory"] = get_mods_directory() + "/" + p_mod_name;
-
- 
-
-	return info;
-
+	ERR_FAIL_NULL_V(QModCatalog::get_singleton(), Dictionary());
+	return QModCatalog::get_singleton()->get_mod_info(p_mod_name);
 }
 
- 
+int QModLoader::get_mod_count(const String &p_type, const String &p_title) {
+	ERR_FAIL_NULL_V(QModCatalog::get_singleton(), 0);
+	return QModCatalog::get_singleton()->get_mod_count(p_type, p_title);
+}
 
-Error QModLoader::load_mod_scene(const String &p_mod_name) {
+Array QModLoader::query_mods(int p_offset, int p_count, const String &p_type, const String &p_title) {
+	ERR_FAIL_NULL_V(QModCatalog::get_singleton(), Array());
+	return QModCatalog::get_singleton()->query_mods(p_offset, p_count, p_type, p_title);
+}
 
+Error QModLoader::_get_scene_path(const String &p_mod_name, String &r_scene_path) {
 	Dictionary info = get_mod_info(p_mod_name);
-
 	if (info.is_empty()) {
-
 		return ERR_FILE_NOT_FOUND;
-
 	}
 
- 
-
 	String scene_file = info.get("scene", "");
-
 	if (scene_file.is_empty()) {
-
 		ERR_PRINT("Mod scene file not specified in mod.json");
-
 		return ERR_FILE_NOT_FOUND;
-
 	}
 
- 
-
-	String scene_path = String(info["mod_directory"]) + "/" + scene_file;
+	r_scene_path = String(info["mod_directory"]) + "/" + scene_file;
+	// The scene is read through the mount, so it must exist before loading starts.
+	return _mount_mod(p_mod_name);
+}
 
- 
+Ref<PackedScene> QModLoader::load_mod_scene(const String &p_mod_name) {
+	// Requesting first lets the dependencies load in parallel while this thread waits.
+	if (request_mod_scene(p_mod_name) != OK) {
+		return Ref<PackedScene>();
+	}
+	return get_mod_scene(p_mod_name);
+}
 
-	Ref<PackedScene> scene = ResourceLoader::load(scene_path);
+Error QModLoader::request_mod_scene(const String &p_mod_name) {
+	String scene_path;
+	Error err = _get_scene_path(p_mod_name, scene_path);
+	if (err != OK) {
+		return err;
+	}
 
-	if (scene.is_null()) {
+	err = ResourceLoader::load_threaded_request(scene_path, "PackedScene", true);
+	if (err != OK) {
+		ERR_PRINT("Could not start loading mod scene: " + scene_path);
+		return err;
+	}
 
-		ERR_PRINT("Could not load mod scene: " + scene_path);
+	MutexLock lock(scene_requests_mutex);
+	SceneRequest &request = scene_requests[p_mod_name];
+	request.path = scene_path;
+	request.count++;
+	return OK;
+}
 
-		return ERR_FILE_CANT_READ;
+String QModLoader::_get_requested_scene_path(const String &p_mod_name) {
+	MutexLock lock(scene_requests_mutex);
+	HashMap<String, SceneRequest>::ConstIterator E = scene_requests.find(p_mod_name);
+	return E ? E->value.path : String();
+}
 
+Error QModLoader::request_mod_scenes(const PackedStringArray &p_mod_names) {
+	// All requests are queued before any of them is waited on, so the mods load side by side.
+	Error result = OK;
+	for (const String &mod_name : p_mod_names) {
+		Error err = request_mod_scene(mod_name);
+		if (err != OK && result == OK) {
+			result = err;
+		}
 	}
+	return result;
+}
 
- 
-
-	// Scene loaded successfully - the user can instantiate it as needed
+QModLoader::SceneLoadStatus QModLoader::get_mod_scene_status(const String &p_mod_name, Array r_progress) {
+	// Meant to be polled every frame, so it only looks up what request_mod_scene() resolved.
+	String scene_path = _get_requested_scene_path(p_mod_name);
+	if (scene_path.is_empty()) {
+		return SCENE_LOAD_INVALID;
+	}
 
-	print_line("Mod scene loaded successfully: " + scene_path);
+	// Progress being the default array indicates the user hasn't requested for it to be computed.
+	const bool return_progress = !ClassDB::is_default_array_arg(r_progress);
+	float progress = 0;
+	ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(scene_path, return_progress ? &progress : nullptr);
+	if (return_progress) {
+		r_progress.resize(1);
+		r_progress[0] = progress;
+	}
+	return (SceneLoadStatus)status;
+}
 
-	return OK;
+Ref<PackedScene> QModLoader::get_mod_scene(const String &p_mod_name) {
+	String scene_path;
+	{
+		MutexLock lock(scene_requests_mutex);
+		HashMap<String, SceneRequest>::Iterator E = scene_requests.find(p_mod_name);
+		ERR_FAIL_COND_V_MSG(!E, Ref<PackedScene>(), "Mod scene was not requested: " + p_mod_name);
+		scene_path = E->value.path;
+		E->value.count--;
+		if (E->value.count == 0) {
+			scene_requests.remove(E);
+		}
+	}
 
+	Error err = OK;
+	Ref<PackedScene> scene = ResourceLoader::load_threaded_get(scene_path, &err);
+	if (scene.is_null()) {
+		ERR_PRINT(vformat("Could not load mod scene: %s (%s).", scene_path, error_names[err]));
+	}
+	return scene;
 }
 
- 
-
 QModLoader::QModLoader() {
-
 }
@@ -32,14 +32,29 @@
 #define QMOD_LOADER_H
 
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class PackedScene;
 
 class QModLoader : public RefCounted {
 	GDCLASS(QModLoader, RefCounted);
 
+	friend class QModCatalog;
+
 protected:
-        static void _bind_methods();
+	static void _bind_methods();
 
 public:
+	// Mirrors ResourceLoader::ThreadLoadStatus.
+	enum SceneLoadStatus {
+		SCENE_LOAD_INVALID,
+		SCENE_LOAD_IN_PROGRESS,
+		SCENE_LOAD_FAILED,
+		SCENE_LOAD_LOADED,
+	};
+
 	struct ModInfo {
 		String title;
 		String description;
@@ -53,16 +68,41 @@ public:
 	Error uninstall_qmod(const String &p_mod_name);
 	Array get_installed_mods();
 	Dictionary get_mod_info(const String &p_mod_name);
-        Error load_mod_scene(const String &p_mod_name);
+	int get_mod_count(const String &p_type = String(), const String &p_title = String());
+	Array query_mods(int p_offset, int p_count, const String &p_type = String(), const String &p_title = String());
+	Ref<PackedScene> load_mod_scene(const String &p_mod_name);
+
+	// Threaded loading: the scene and its dependencies load on worker threads
+	// until get_mod_scene() is called, which blocks only if they're not done yet.
+	Error request_mod_scene(const String &p_mod_name);
+	Error request_mod_scenes(const PackedStringArray &p_mod_names);
+	SceneLoadStatus get_mod_scene_status(const String &p_mod_name, Array r_progress = ClassDB::default_array_arg);
+	Ref<PackedScene> get_mod_scene(const String &p_mod_name);
 
-        static String get_mods_directory();
+	static String get_mods_directory();
 
-        QModLoader();
+	QModLoader();
 
 private:
-        Error _copy_dir(const String &p_from, const String &p_to);
-        Error _copy_file(const String &p_from, const String &p_to);
-        Error _remove_dir_recursive(const String &p_dir);
+	// Scenes requested for threaded loading, resolved and mounted once when requested.
+	struct SceneRequest {
+		String path;
+		uint32_t count = 0; // Like ResourceLoader, a request lasts until each call to request_mod_scene() was matched by get_mod_scene().
+	};
+
+	BinaryMutex scene_requests_mutex;
+	HashMap<String, SceneRequest> scene_requests;
+
+	static String _get_archive_path(const String &p_mod_name);
+	static Error _parse_metadata(const String &p_json, Dictionary &r_metadata);
+	static Error _mount_mod(const String &p_mod_name);
+	static Error _read_metadata(const String &p_mod_name, Dictionary &r_metadata);
+	Error _get_scene_path(const String &p_mod_name, String &r_scene_path);
+	String _get_requested_scene_path(const String &p_mod_name);
+	static void _list_dir_files(const String &p_dir, const String &p_relative, LocalVector<String> &r_files);
+	Error _remove_dir_recursive(const String &p_dir);
 };
 
+VARIANT_ENUM_CAST(QModLoader::SceneLoadStatus);
+
 #endif // QMOD_LOADER_H
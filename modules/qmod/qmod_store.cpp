@@ -0,0 +1,206 @@
+/**************************************************************************/
+/*  qmod_store.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "qmod_store.h"
+
+#include "qmod_archive.h"
+#include "qmod_loader.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+
+Error QModManifest::load(const String &p_path) {
+	entries.clear();
+
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	ERR_FAIL_COND_V_MSG(f->get_32() != QMOD_MANIFEST_MAGIC, ERR_FILE_UNRECOGNIZED, vformat("Not a mod manifest: '%s'.", p_path));
+	ERR_FAIL_COND_V_MSG(f->get_32() != QMOD_MANIFEST_VERSION, ERR_FILE_UNRECOGNIZED, vformat("Unsupported mod manifest version: '%s'.", p_path));
+
+	uint32_t count = f->get_32();
+	// Each entry takes at least a path length, a size and a hash, so a corrupt count is caught before allocating.
+	const uint64_t min_entry_size = 4 + 8 + 32;
+	ERR_FAIL_COND_V_MSG(count > (f->get_length() - f->get_position()) / min_entry_size, ERR_FILE_CORRUPT, vformat("Mod manifest is truncated: '%s'.", p_path));
+	entries.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		Entry &entry = entries[i];
+		entry.path = f->get_pascal_string();
+		if (!QModArchive::is_valid_entry_path(entry.path)) {
+			entries.clear();
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("Mod manifest has an invalid file path '%s': '%s'.", entry.path, p_path));
+		}
+		entry.size = f->get_64();
+		uint8_t hash[32];
+		f->get_buffer(hash, 32);
+		entry.hash = String::hex_encode_buffer(hash, 32);
+	}
+
+	if (f->eof_reached()) {
+		entries.clear();
+		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("Mod manifest is truncated: '%s'.", p_path));
+	}
+	return OK;
+}
+
+Error QModManifest::save(const String &p_path) const {
+	// Write next to the destination and rename over it, so a crash can't leave a half-written manifest.
+	String temp_path = p_path + ".tmp";
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+		if (f.is_null()) {
+			return ERR_FILE_CANT_WRITE;
+		}
+
+		f->store_32(QMOD_MANIFEST_MAGIC);
+		f->store_32(QMOD_MANIFEST_VERSION);
+		f->store_32(entries.size());
+		for (const Entry &entry : entries) {
+			f->store_pascal_string(entry.path);
+			f->store_64(entry.size);
+			Vector<uint8_t> hash = entry.hash.hex_decode();
+			ERR_FAIL_COND_V(hash.size() != 32, ERR_INVALID_DATA);
+			f->store_buffer(hash.ptr(), 32);
+		}
+
+		if (f->get_error() != OK) {
+			return ERR_FILE_CANT_WRITE;
+		}
+	}
+
+	Error err = DirAccess::rename_absolute(temp_path, p_path);
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+	return err;
+}
+
+void QModManifest::get_hashes(HashSet<String> &r_hashes) const {
+	for (const Entry &entry : entries) {
+		r_hashes.insert(entry.hash);
+	}
+}
+
+String QModStore::get_store_directory() {
+	return QModLoader::get_mods_directory() + "/.store";
+}
+
+String QModStore::get_blob_path(const String &p_hash) {
+	return get_store_directory() + "/" + p_hash.substr(0, 2) + "/" + p_hash;
+}
+
+String QModStore::get_manifest_path(const String &p_mod_name) {
+	return QModLoader::get_mods_directory() + "/" + p_mod_name + ".manifest";
+}
+
+String QModStore::hash_buffer(const uint8_t *p_data, uint64_t p_size) {
+	CryptoCore::SHA256Context ctx;
+	ctx.start();
+	ctx.update(p_data, p_size);
+	unsigned char hash[32];
+	ctx.finish(hash);
+	return String::hex_encode_buffer(hash, 32);
+}
+
+Error QModStore::store_blob(const String &p_hash, const uint8_t *p_data, uint64_t p_size, bool &r_written) {
+	r_written = false;
+
+	String blob_path = get_blob_path(p_hash);
+	if (FileAccess::exists(blob_path)) {
+		return OK; // Already stored, by this mod or another one.
+	}
+
+	Error err = DirAccess::make_dir_recursive_absolute(blob_path.get_base_dir());
+	if (err != OK) {
+		return err;
+	}
+
+	String temp_path = blob_path + ".tmp";
+	{
+		Ref<FileAccess> f = FileAccess::open(temp_path, FileAccess::WRITE);
+		if (f.is_null()) {
+			return ERR_FILE_CANT_WRITE;
+		}
+		if (!f->store_buffer(p_data, p_size)) {
+			f.unref();
+			DirAccess::remove_absolute(temp_path);
+			return ERR_FILE_CANT_WRITE;
+		}
+	}
+
+	err = DirAccess::rename_absolute(temp_path, blob_path);
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+		return err;
+	}
+
+	r_written = true;
+	return OK;
+}
+
+Error QModStore::release_blobs(const HashSet<String> &p_hashes, const String &p_ignored_manifest) {
+	if (p_hashes.is_empty()) {
+		return OK;
+	}
+
+	HashSet<String> unused = p_hashes;
+
+	// Only manifests are scanned, so this scales with the number of mods rather than the store size.
+	Ref<DirAccess> dir = DirAccess::open(QModLoader::get_mods_directory());
+	if (dir.is_valid()) {
+		dir->list_dir_begin();
+		String file_name = dir->get_next();
+		while (!file_name.is_empty() && !unused.is_empty()) {
+			if (!dir->current_is_dir() && file_name.get_extension() == "manifest") {
+				String manifest_path = QModLoader::get_mods_directory() + "/" + file_name;
+				QModManifest manifest;
+				if (manifest_path != p_ignored_manifest && manifest.load(manifest_path) == OK) {
+					for (const QModManifest::Entry &entry : manifest.entries) {
+						unused.erase(entry.hash);
+					}
+				}
+			}
+			file_name = dir->get_next();
+		}
+		dir->list_dir_end();
+	}
+
+	Error result = OK;
+	for (const String &hash : unused) {
+		String blob_path = get_blob_path(hash);
+		if (FileAccess::exists(blob_path) && DirAccess::remove_absolute(blob_path) != OK) {
+			result = ERR_FILE_CANT_WRITE;
+		}
+	}
+	return result;
+}
@@ -0,0 +1,76 @@
+/**************************************************************************/
+/*  qmod_store.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+// Content-addressed storage for installed mods. Every file is stored once
+// under `user://mods/.store/<first two hex digits>/<sha256>`, no matter how
+// many mods (or versions of a mod) ship it. Each installed mod has a
+// manifest, `user://mods/<mod>.manifest`, mapping its paths to blobs:
+//
+//   u32 magic, u32 version, u32 entry count, then per entry:
+//   pascal string path, u64 size, 32 byte SHA-256.
+
+#define QMOD_MANIFEST_MAGIC 0x464D4D51 // "QMMF"
+#define QMOD_MANIFEST_VERSION 1
+
+class QModManifest {
+public:
+	struct Entry {
+		String path;
+		uint64_t size = 0;
+		String hash; // Lowercase hex SHA-256 of the contents.
+	};
+
+	LocalVector<Entry> entries;
+
+	Error load(const String &p_path);
+	Error save(const String &p_path) const;
+
+	void get_hashes(HashSet<String> &r_hashes) const;
+};
+
+class QModStore {
+public:
+	static String get_store_directory();
+	static String get_blob_path(const String &p_hash);
+	static String get_manifest_path(const String &p_mod_name);
+
+	static String hash_buffer(const uint8_t *p_data, uint64_t p_size);
+	// Writes the blob for `p_hash` (see hash_buffer()) unless the store already
+	// has it; `r_written` tells which.
+	static Error store_blob(const String &p_hash, const uint8_t *p_data, uint64_t p_size, bool &r_written);
+	// Deletes the given blobs unless a manifest other than `p_ignored_manifest` still references them.
+	static Error release_blobs(const HashSet<String> &p_hashes, const String &p_ignored_manifest = String());
+};
@@ -1,6 +1,8 @@
 #include "register_types.h"
 
 #include "core/object/class_db.h"
+#include "file_access_qmod.h"
+#include "qmod_catalog.h"
 #include "qmod_exporter.h"
 #include "qmod_loader.h"
 
@@ -13,6 +15,12 @@ void initialize_qmod_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
 		GDREGISTER_CLASS(QModExporter);
 		GDREGISTER_CLASS(QModLoader);
+
+		// Mounted archives are served through the pack file system, which owns the source.
+		if (PackedData::get_singleton()) {
+			PackedData::get_singleton()->add_pack_source(memnew(PackSourceQMod));
+		}
+		memnew(QModCatalog);
 	}
 
 #ifdef TOOLS_ENABLED
@@ -24,7 +32,9 @@ void initialize_qmod_module(ModuleInitializationLevel p_level) {
 
 void uninitialize_qmod_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
-		// Nothing to clean up for scene level.
+		if (QModCatalog::get_singleton()) {
+			memdelete(QModCatalog::get_singleton());
+		}
 	}
 
 #ifdef TOOLS_ENABLED
@@ -0,0 +1,268 @@
+/**************************************************************************/
+/*  test_qmod_archive.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../file_access_qmod.h"
+#include "../qmod_archive.h"
+
+#include "core/io/dir_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestQModArchive {
+
+static String write_test_archive(const String &p_name) {
+	String path = TestUtils::get_temp_path(p_name);
+	QModArchiveWriter writer;
+	CHECK(writer.open(path) == OK);
+
+	const CharString json = String("{\"title\": \"Test Mod\"}").utf8();
+	CHECK(writer.add_buffer("mod.json", (const uint8_t *)json.get_data(), json.length()) == OK);
+
+	Vector<uint8_t> blob;
+	blob.resize(1000);
+	for (int i = 0; i < blob.size(); i++) {
+		blob.write[i] = i % 251;
+	}
+	CHECK(writer.add_buffer("textures/blob.bin", blob.ptr(), blob.size()) == OK);
+	CHECK(writer.add_buffer("empty.txt", nullptr, 0) == OK);
+	CHECK(writer.add_buffer("mod.json", (const uint8_t *)json.get_data(), json.length()) == ERR_ALREADY_EXISTS);
+	CHECK(writer.finish() == OK);
+	return path;
+}
+
+TEST_CASE("[Modules][QMod] Archive round trip") {
+	String path = write_test_archive("qmod_round_trip.qmod");
+
+	Ref<QModArchive> archive;
+	archive.instantiate();
+	REQUIRE(archive->open(path) == OK);
+	CHECK(archive->get_file_count() == 3);
+
+	Error err = FAILED;
+	CHECK(archive->get_file_as_string("mod.json", &err) == "{\"title\": \"Test Mod\"}");
+	CHECK(err == OK);
+
+	int idx = archive->find_file("textures/blob.bin");
+	REQUIRE(idx >= 0);
+	CHECK(archive->get_file_path(idx) == "textures/blob.bin");
+	CHECK(archive->get_file_size(idx) == 1000);
+	CHECK_MESSAGE(archive->get_file_offset(idx) % QMOD_DATA_ALIGNMENT == 0, "File blobs should be aligned.");
+	const uint8_t *data = archive->get_file_data(idx);
+	bool matches = true;
+	for (int i = 0; i < 1000; i++) {
+		matches = matches && data[i] == i % 251;
+	}
+	CHECK(matches);
+
+	idx = archive->find_file("empty.txt");
+	REQUIRE(idx >= 0);
+	CHECK(archive->get_file_size(idx) == 0);
+
+	// Lookups are normalized like PackedData paths.
+	CHECK(archive->find_file("res://textures/blob.bin") == archive->find_file("textures/blob.bin"));
+	CHECK(archive->find_file("textures/../textures/blob.bin") == archive->find_file("textures/blob.bin"));
+	CHECK(archive->find_file("textures//blob.bin") == archive->find_file("textures/blob.bin"));
+
+	CHECK(archive->find_file("missing.txt") == -1);
+	CHECK(archive->find_file("textures") == -1);
+
+	archive.unref();
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[Modules][QMod] Compressed files") {
+	// Spans several chunks, the first half compresses well and the rest doesn't.
+	const uint64_t size = QMOD_CHUNK_SIZE * 2 + 1234;
+	Vector<uint8_t> source;
+	source.resize(size);
+	uint32_t seed = 12345;
+	for (uint64_t i = 0; i < size; i++) {
+		seed = seed * 1103515245 + 12345;
+		source.write[i] = i < size / 2 ? (i / 64) % 7 : (seed >> 16) & 0xFF;
+	}
+	String source_path = TestUtils::get_temp_path("qmod_compressed_source.bin");
+	Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_buffer(source.ptr(), source.size());
+	f->close();
+
+	String text_path = TestUtils::get_temp_path("qmod_compressed_source.txt");
+	f = FileAccess::open(text_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string("Compressed text");
+	f->close();
+
+	String path = TestUtils::get_temp_path("qmod_compressed.qmod");
+	QModArchiveWriter writer;
+	REQUIRE(writer.open(path) == OK);
+	CHECK(writer.add_file("data/large.bin", source_path, true) == OK);
+	CHECK(writer.add_file("text.txt", text_path, true) == OK);
+	CHECK(writer.add_file("plain.bin", source_path, false) == OK);
+	REQUIRE(writer.finish() == OK);
+
+	Ref<QModArchive> archive;
+	archive.instantiate();
+	REQUIRE(archive->open(path) == OK);
+
+	int idx = archive->find_file("data/large.bin");
+	REQUIRE(idx >= 0);
+	CHECK(archive->is_file_compressed(idx));
+	CHECK(archive->get_file_size(idx) == size);
+	CHECK(archive->get_file_stored_size(idx) < size);
+	CHECK(archive->find_compressed_file(archive->get_file_offset(idx)) == idx);
+
+	Vector<uint8_t> contents;
+	contents.resize(size);
+	REQUIRE(archive->read_file(idx, contents.ptrw()) == OK);
+	CHECK(contents == source);
+
+	idx = archive->find_file("plain.bin");
+	REQUIRE(idx >= 0);
+	CHECK_FALSE(archive->is_file_compressed(idx));
+	CHECK(archive->get_file_stored_size(idx) == size);
+	CHECK(archive->find_compressed_file(archive->get_file_offset(idx)) == -1);
+
+	CHECK(archive->get_file_as_string("text.txt") == "Compressed text");
+
+	archive.unref();
+	DirAccess::remove_absolute(path);
+	DirAccess::remove_absolute(source_path);
+	DirAccess::remove_absolute(text_path);
+}
+
+TEST_CASE("[Modules][QMod] Archive rejects invalid data") {
+	String path = TestUtils::get_temp_path("qmod_invalid.qmod");
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string("This is not a QMOD archive, just some text that is long enough to hold a header.");
+	f->close();
+
+	Ref<QModArchive> archive;
+	archive.instantiate();
+	ERR_PRINT_OFF;
+	CHECK(archive->open(path) == ERR_FILE_UNRECOGNIZED);
+	ERR_PRINT_ON;
+	CHECK(archive->get_file_count() == 0);
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[Modules][QMod] Archive paths can't escape the mount point") {
+	CHECK(QModArchive::is_valid_entry_path("textures/blob.bin"));
+	CHECK_FALSE(QModArchive::is_valid_entry_path(""));
+	CHECK_FALSE(QModArchive::is_valid_entry_path("../blob.bin"));
+	CHECK_FALSE(QModArchive::is_valid_entry_path("textures/../../blob.bin"));
+	CHECK_FALSE(QModArchive::is_valid_entry_path("textures/.."));
+	CHECK_FALSE(QModArchive::is_valid_entry_path("/etc/blob.bin"));
+	CHECK_FALSE(QModArchive::is_valid_entry_path("C:/blob.bin"));
+	CHECK_FALSE(QModArchive::is_valid_entry_path("user://blob.bin"));
+	CHECK_FALSE(QModArchive::is_valid_entry_path("textures\\..\\..\\blob.bin"));
+
+	String path = TestUtils::get_temp_path("qmod_traversal.qmod");
+	QModArchiveWriter writer;
+	REQUIRE(writer.open(path) == OK);
+	ERR_PRINT_OFF;
+	CHECK(writer.add_buffer("a/../../escaped.txt", nullptr, 0) == ERR_INVALID_PARAMETER);
+	CHECK(writer.add_buffer("/escaped.txt", nullptr, 0) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+	// Written with a harmless path, then patched to climb out of the mount point.
+	CHECK(writer.add_buffer("xx/escaped.txt", nullptr, 0) == OK);
+	REQUIRE(writer.finish() == OK);
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ_WRITE);
+	REQUIRE(f.is_valid());
+	Vector<uint8_t> contents = f->get_buffer(f->get_length());
+	const CharString needle = String("xx/escaped.txt").utf8();
+	int64_t found = -1;
+	for (int64_t i = 0; i + needle.length() <= contents.size() && found < 0; i++) {
+		if (memcmp(contents.ptr() + i, needle.get_data(), needle.length()) == 0) {
+			found = i;
+		}
+	}
+	REQUIRE(found >= 0);
+	f->seek(found);
+	f->store_buffer((const uint8_t *)"..", 2);
+	f->close();
+
+	Ref<QModArchive> archive;
+	archive.instantiate();
+	ERR_PRINT_OFF;
+	CHECK(archive->open(path) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+	CHECK(archive->get_file_count() == 0);
+
+	archive.unref();
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[Modules][QMod] Mounted archive is readable through FileAccess") {
+	String path = write_test_archive("qmod_mount.qmod");
+
+	// Tests don't go through Main::setup(), so provide the pack file system locally.
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+	PackSourceQMod *source = PackSourceQMod::get_singleton();
+	if (!source) {
+		source = memnew(PackSourceQMod);
+		PackedData::get_singleton()->add_pack_source(source);
+	}
+
+	const String mount_point = "user://mods/test_mod";
+	REQUIRE(source->mount(path, mount_point, true) == OK);
+	CHECK(FileAccess::exists(mount_point.path_join("mod.json")));
+	CHECK(FileAccess::exists(mount_point.path_join("textures/../textures/blob.bin")));
+
+	Ref<FileAccess> fa = FileAccess::open(mount_point.path_join("textures/blob.bin"), FileAccess::READ);
+	REQUIRE(fa.is_valid());
+	CHECK(fa->get_length() == 1000);
+	fa->seek(250);
+	CHECK(fa->get_8() == 250);
+	CHECK(fa->get_8() == 0);
+	fa->seek_end(-1);
+	CHECK(fa->get_8() == 999 % 251);
+	CHECK_FALSE(fa->eof_reached());
+	fa->get_8();
+	CHECK(fa->eof_reached());
+
+	// Unmounting keeps already opened files valid.
+	source->unmount(path);
+	CHECK_FALSE(FileAccess::exists(mount_point.path_join("mod.json")));
+	fa->seek(0);
+	CHECK(fa->get_8() == 0);
+	fa.unref();
+
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+	DirAccess::remove_absolute(path);
+}
+
+} // namespace TestQModArchive
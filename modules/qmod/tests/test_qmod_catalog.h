@@ -0,0 +1,222 @@
+/**************************************************************************/
+/*  test_qmod_catalog.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../qmod_catalog.h"
+#include "../qmod_loader.h"
+#include "../qmod_store.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "tests/test_macros.h"
+
+namespace TestQModCatalog {
+
+// Legacy mods are plain directories, so they don't need to be mounted to be listed.
+static void write_mod(const String &p_mod_name, const String &p_title, const String &p_type) {
+	String mod_dir = QModLoader::get_mods_directory().path_join(p_mod_name);
+	DirAccess::make_dir_recursive_absolute(mod_dir);
+	Ref<FileAccess> f = FileAccess::open(mod_dir.path_join("mod.json"), FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(vformat("{\"title\": \"%s\", \"type\": \"%s\"}", p_title, p_type));
+}
+
+static void remove_mods(const Vector<String> &p_mod_names) {
+	for (const String &mod_name : p_mod_names) {
+		String mod_dir = QModLoader::get_mods_directory().path_join(mod_name);
+		DirAccess::remove_absolute(mod_dir.path_join("mod.json"));
+		DirAccess::remove_absolute(mod_dir);
+	}
+	// Rebuilt by the next query.
+	DirAccess::remove_absolute(QModCatalog::get_catalog_path());
+}
+
+static void store_variant(const Ref<FileAccess> &p_file, const Variant &p_value) {
+	int len = 0;
+	encode_variant(p_value, nullptr, len);
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	encode_variant(p_value, buffer.ptrw(), len);
+	p_file->store_buffer(buffer.ptr(), len);
+}
+
+// Stores the stamp a catalog keeps for a legacy mod, as if its mod.json held `p_contents` when it was saved.
+static void store_stamp(const Ref<FileAccess> &p_file, const String &p_mod_name, const String &p_contents) {
+	const String json_path = QModLoader::get_mods_directory().path_join(p_mod_name).path_join("mod.json");
+	const CharString contents = p_contents.utf8();
+	p_file->store_64(FileAccess::get_modified_time(json_path));
+	p_file->store_64(contents.length());
+	p_file->store_buffer(QModStore::hash_buffer((const uint8_t *)contents.get_data(), contents.length()).hex_decode());
+}
+
+static String get_title(QModCatalog &p_catalog, const String &p_mod_name) {
+	return p_catalog.get_mod_info(p_mod_name).get("title", String());
+}
+
+TEST_CASE("[Modules][QMod] Catalog round trip") {
+	write_mod("catalog_test_a", "Catalog Test Alpha", "skin");
+	write_mod("catalog_test_b", "Catalog Test Beta", "level");
+
+	{
+		QModCatalog catalog;
+		CHECK(catalog.has_mod("catalog_test_a"));
+		CHECK(get_title(catalog, "catalog_test_b") == "Catalog Test Beta");
+	}
+	REQUIRE(FileAccess::exists(QModCatalog::get_catalog_path()));
+
+	// Editing a mod.json in place doesn't touch the mods directory, so a new catalog serves what was saved.
+	write_mod("catalog_test_a", "Catalog Test Renamed", "skin");
+	{
+		QModCatalog catalog;
+		CHECK(get_title(catalog, "catalog_test_a") == "Catalog Test Alpha");
+		Dictionary info = catalog.get_mod_info("catalog_test_b");
+		CHECK(info.get("type", String()) == "level");
+		CHECK(info.get("mod_directory", String()) == QModLoader::get_mods_directory() + "/catalog_test_b");
+	}
+
+	remove_mods({ "catalog_test_a", "catalog_test_b" });
+}
+
+TEST_CASE("[Modules][QMod] Catalog rescans changed mods") {
+	write_mod("catalog_test_a", "Catalog Test Alpha", "skin");
+	write_mod("catalog_test_b", "Catalog Test Beta", "level");
+	const String catalog_path = QModCatalog::get_catalog_path();
+	DirAccess::make_dir_recursive_absolute(catalog_path.get_base_dir());
+
+	SUBCASE("Only mods changed since the catalog was saved are read again") {
+		{
+			// Saved before the mods directory last changed: `a` changed since, `b` didn't, and `c` was removed.
+			Ref<FileAccess> f = FileAccess::open(catalog_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_32(QMOD_CATALOG_MAGIC);
+			f->store_32(QMOD_CATALOG_VERSION);
+			f->store_64(0);
+			f->store_32(3);
+			store_stamp(f, "catalog_test_a", "{}");
+			store_variant(f, "catalog_test_a");
+			store_variant(f, Dictionary({ { "title", "Stale" } }));
+			store_stamp(f, "catalog_test_b", FileAccess::get_file_as_string(QModLoader::get_mods_directory().path_join("catalog_test_b/mod.json")));
+			store_variant(f, "catalog_test_b");
+			store_variant(f, Dictionary({ { "title", "Cached Beta" } }));
+			const uint8_t no_hash[32] = {};
+			f->store_64(1);
+			f->store_64(0);
+			f->store_buffer(no_hash, 32);
+			store_variant(f, "catalog_test_c");
+			store_variant(f, Dictionary({ { "title", "Removed" } }));
+		}
+
+		QModCatalog catalog;
+		CHECK(get_title(catalog, "catalog_test_a") == "Catalog Test Alpha");
+		CHECK(get_title(catalog, "catalog_test_b") == "Cached Beta");
+		CHECK_FALSE(catalog.has_mod("catalog_test_c"));
+	}
+
+	SUBCASE("Mods rewritten within the same second are read again") {
+		const String json_path = QModLoader::get_mods_directory().path_join("catalog_test_a/mod.json");
+		const String contents = FileAccess::get_file_as_string(json_path);
+		{
+			// Same modification time and size as the mod.json on disk, but other contents.
+			Ref<FileAccess> f = FileAccess::open(catalog_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_32(QMOD_CATALOG_MAGIC);
+			f->store_32(QMOD_CATALOG_VERSION);
+			f->store_64(0);
+			f->store_32(1);
+			store_stamp(f, "catalog_test_a", contents.replace("Alpha", "Omega"));
+			store_variant(f, "catalog_test_a");
+			store_variant(f, Dictionary({ { "title", "Catalog Test Omega" } }));
+		}
+
+		QModCatalog catalog;
+		CHECK(get_title(catalog, "catalog_test_a") == "Catalog Test Alpha");
+	}
+
+	SUBCASE("A corrupt catalog is rebuilt") {
+		{
+			Ref<FileAccess> f = FileAccess::open(catalog_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_32(QMOD_CATALOG_MAGIC);
+			f->store_32(QMOD_CATALOG_VERSION);
+			f->store_64(0);
+			f->store_32(0xFFFFFFFF);
+		}
+
+		QModCatalog catalog;
+		ERR_PRINT_OFF;
+		CHECK(catalog.has_mod("catalog_test_a"));
+		ERR_PRINT_ON;
+		CHECK(get_title(catalog, "catalog_test_b") == "Catalog Test Beta");
+	}
+
+	remove_mods({ "catalog_test_a", "catalog_test_b" });
+}
+
+TEST_CASE("[Modules][QMod] Catalog paging and filtering") {
+	Vector<String> mod_names;
+	for (int i = 0; i < 5; i++) {
+		mod_names.push_back(vformat("catalog_test_page_%d", i));
+		write_mod(mod_names[i], vformat("Catalog Test Page %d", i), "catalog_test");
+	}
+
+	QModCatalog catalog;
+	CHECK(catalog.get_mod_count("catalog_test") == 5);
+
+	// Pages follow the order of the mod names.
+	for (int offset = 0; offset < 6; offset += 2) {
+		Array page = catalog.query_mods(offset, 2, "catalog_test");
+		CHECK(page.size() == MIN(2, 5 - offset));
+		for (int i = 0; i < page.size(); i++) {
+			CHECK(Dictionary(page[i]).get("title", String()) == vformat("Catalog Test Page %d", offset + i));
+		}
+	}
+	CHECK(catalog.query_mods(5, 2, "catalog_test").is_empty());
+
+	// Titles match case-insensitively as substrings.
+	CHECK(catalog.get_mod_count("catalog_test", "page 3") == 1);
+	Array page = catalog.query_mods(0, 10, "catalog_test", "PAGE 3");
+	REQUIRE(page.size() == 1);
+	CHECK(Dictionary(page[0]).get("title", String()) == "Catalog Test Page 3");
+	CHECK(catalog.get_mod_count("catalog_test", "missing") == 0);
+
+	// Installing and uninstalling refreshes cached results.
+	CHECK(catalog.get_mod_count("catalog_test") == 5);
+	catalog.set_mod("catalog_test_page_5", Dictionary({ { "title", "Catalog Test Page 5" }, { "type", "catalog_test" } }));
+	CHECK(catalog.get_mod_count("catalog_test") == 6);
+	catalog.remove_mod("catalog_test_page_0");
+	CHECK(catalog.get_mod_count("catalog_test") == 5);
+	CHECK(Dictionary(catalog.query_mods(0, 1, "catalog_test")[0]).get("title", String()) == "Catalog Test Page 1");
+
+	remove_mods(mod_names);
+}
+
+} // namespace TestQModCatalog
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  test_qmod_exporter.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../file_access_qmod.h"
+#include "../qmod_exporter.h"
+#include "../qmod_loader.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_saver.h"
+#include "core/io/resource_uid.h"
+#include "scene/resources/packed_scene.h"
+#include "tests/core/config/test_project_settings.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestQModExporter {
+
+static void write_project_file(const String &p_path, const String &p_contents) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(p_contents);
+}
+
+TEST_CASE("[Modules][QMod] Exported scenes load their dependencies from the mod") {
+	// Tests don't go through Main::setup(), so provide the pack file system locally.
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+	if (!PackSourceQMod::get_singleton()) {
+		PackedData::get_singleton()->add_pack_source(memnew(PackSourceQMod));
+	}
+
+	// A small project with a scene that references an imported file by UID.
+	String &resource_path = TestProjectSettingsInternalsAccessor::resource_path();
+	const String old_resource_path = resource_path;
+	const String project_path = TestUtils::get_temp_path("qmod_export_project");
+	resource_path = project_path;
+	REQUIRE(DirAccess::make_dir_recursive_absolute("res://levels") == OK);
+	REQUIRE(DirAccess::make_dir_recursive_absolute("res://textures") == OK);
+	REQUIRE(DirAccess::make_dir_recursive_absolute("res://.godot/imported") == OK);
+
+	Ref<Resource> imported;
+	imported.instantiate();
+	imported->set_name("Imported tile");
+	REQUIRE(ResourceSaver::save(imported, "res://.godot/imported/tile.data-0123.res") == OK);
+	write_project_file("res://textures/tile.data", "Source data");
+	write_project_file("res://textures/tile.data.import", "[remap]\n\nimporter=\"qmod_test\"\ntype=\"Resource\"\npath=\"res://.godot/imported/tile.data-0123.res\"\n");
+
+	const ResourceUID::ID uid = ResourceUID::get_singleton()->create_id();
+	ResourceUID::get_singleton()->add_id(uid, "res://textures/tile.data");
+	const String scene_text = "[gd_scene load_steps=2 format=3]\n\n"
+							  "[ext_resource type=\"Resource\" uid=\"%s\" path=\"res://textures/tile.data\" id=\"1_tile\"]\n\n"
+							  "[node name=\"Level\" type=\"Node\"]\n"
+							  "metadata/tile = ExtResource(\"1_tile\")\n";
+	write_project_file("res://levels/level.tscn", vformat(scene_text, ResourceUID::get_singleton()->id_to_text(uid)));
+
+	Ref<QModExporter> exporter;
+	exporter.instantiate();
+	exporter->set_title("Export Test Mod");
+	const String qmod_path = TestUtils::get_temp_path("qmod_export_test.qmod");
+	Error err = exporter->export_qmod("res://levels/level.tscn", qmod_path);
+
+	// Once installed, nothing may come from the project anymore.
+	ResourceUID::get_singleton()->remove_id(uid);
+	resource_path = old_resource_path;
+	REQUIRE(err == OK);
+	CHECK_FALSE(FileAccess::exists(qmod_path + ".staging.tscn"));
+
+	Ref<QModLoader> loader;
+	loader.instantiate();
+	REQUIRE(loader->install_qmod(qmod_path) == OK);
+	Ref<PackedScene> scene = loader->load_mod_scene("export_test_mod");
+	REQUIRE(scene.is_valid());
+	Node *instance = scene->instantiate();
+	REQUIRE(instance != nullptr);
+	Ref<Resource> tile = instance->get_meta("tile", Ref<Resource>());
+	REQUIRE(tile.is_valid());
+	CHECK(tile->get_name() == "Imported tile");
+	CHECK(tile->get_path() == QModLoader::get_mods_directory().path_join("export_test_mod/textures/tile.data"));
+	memdelete(instance);
+	tile.unref();
+	scene.unref();
+
+	CHECK(loader->uninstall_qmod("export_test_mod") == OK);
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+	DirAccess::remove_absolute(qmod_path);
+	DirAccess::remove_absolute(project_path.path_join(".godot/imported/tile.data-0123.res"));
+	DirAccess::remove_absolute(project_path.path_join("textures/tile.data"));
+	DirAccess::remove_absolute(project_path.path_join("textures/tile.data.import"));
+	DirAccess::remove_absolute(project_path.path_join("levels/level.tscn"));
+}
+
+} // namespace TestQModExporter
@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  test_qmod_loader.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../qmod_catalog.h"
+#include "../qmod_loader.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/io/resource_saver.h"
+#include "core/os/os.h"
+#include "scene/resources/packed_scene.h"
+#include "tests/test_macros.h"
+
+namespace TestQModLoader {
+
+static String get_test_mod_directory(const String &p_mod_name) {
+	return QModLoader::get_mods_directory().path_join(p_mod_name);
+}
+
+// Installed as a legacy mod, a plain directory with its mod.json, and added to the catalog like install_qmod() does.
+static void write_test_mod(const String &p_mod_name, const Dictionary &p_metadata) {
+	String mod_dir = get_test_mod_directory(p_mod_name);
+	DirAccess::make_dir_recursive_absolute(mod_dir);
+	Ref<FileAccess> f = FileAccess::open(mod_dir.path_join("mod.json"), FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string(JSON::stringify(p_metadata));
+	f.unref();
+
+	REQUIRE(QModCatalog::get_singleton() != nullptr);
+	QModCatalog::get_singleton()->set_mod(p_mod_name, p_metadata);
+}
+
+static QModLoader::SceneLoadStatus wait_for_mod_scene(const Ref<QModLoader> &p_loader, const String &p_mod_name) {
+	QModLoader::SceneLoadStatus status = p_loader->get_mod_scene_status(p_mod_name);
+	const uint64_t begin = OS::get_singleton()->get_ticks_msec();
+	while (status == QModLoader::SCENE_LOAD_IN_PROGRESS && OS::get_singleton()->get_ticks_msec() - begin < 5000) {
+		OS::get_singleton()->delay_usec(1000);
+		status = p_loader->get_mod_scene_status(p_mod_name);
+	}
+	return status;
+}
+
+TEST_CASE("[Modules][QMod] Threaded mod scene loading") {
+	Ref<QModLoader> loader;
+	loader.instantiate();
+
+	SUBCASE("Requested scenes can be polled and collected") {
+		write_test_mod("loader_test_mod", Dictionary({ { "title", "Loader Test Mod" }, { "scene", "scene.tscn" } }));
+		Node *node = memnew(Node);
+		node->set_name("ModRoot");
+		Ref<PackedScene> packed_scene;
+		packed_scene.instantiate();
+		REQUIRE(packed_scene->pack(node) == OK);
+		memdelete(node);
+		REQUIRE(ResourceSaver::save(packed_scene, get_test_mod_directory("loader_test_mod").path_join("scene.tscn")) == OK);
+
+		CHECK(loader->get_mod_scene_status("loader_test_mod") == QModLoader::SCENE_LOAD_INVALID);
+		REQUIRE(loader->request_mod_scene("loader_test_mod") == OK);
+		CHECK(wait_for_mod_scene(loader, "loader_test_mod") == QModLoader::SCENE_LOAD_LOADED);
+
+		Array progress;
+		CHECK(loader->get_mod_scene_status("loader_test_mod", progress) == QModLoader::SCENE_LOAD_LOADED);
+		REQUIRE(progress.size() == 1);
+		CHECK(float(progress[0]) == doctest::Approx(1.0));
+
+		Ref<PackedScene> scene = loader->get_mod_scene("loader_test_mod");
+		REQUIRE(scene.is_valid());
+		Node *instance = scene->instantiate();
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_name() == "ModRoot");
+		memdelete(instance);
+
+		// Collected requests are forgotten.
+		CHECK(loader->get_mod_scene_status("loader_test_mod") == QModLoader::SCENE_LOAD_INVALID);
+
+		CHECK(loader->uninstall_qmod("loader_test_mod") == OK);
+	}
+
+	SUBCASE("Scenes that fail to load report it") {
+		write_test_mod("loader_test_broken", Dictionary({ { "title", "Loader Test Broken" }, { "scene", "broken.tscn" } }));
+		Ref<FileAccess> f = FileAccess::open(get_test_mod_directory("loader_test_broken").path_join("broken.tscn"), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("This is not a scene.");
+		f.unref();
+
+		ERR_PRINT_OFF;
+		REQUIRE(loader->request_mod_scene("loader_test_broken") == OK);
+		CHECK(wait_for_mod_scene(loader, "loader_test_broken") == QModLoader::SCENE_LOAD_FAILED);
+		CHECK(loader->get_mod_scene("loader_test_broken").is_null());
+		CHECK(loader->uninstall_qmod("loader_test_broken") == OK);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Invalid mods can't be requested") {
+		ERR_PRINT_OFF;
+		CHECK(loader->request_mod_scene("loader_test_missing") == ERR_FILE_NOT_FOUND);
+		CHECK(loader->get_mod_scene_status("loader_test_missing") == QModLoader::SCENE_LOAD_INVALID);
+		CHECK(loader->get_mod_scene("loader_test_missing").is_null());
+
+		// Installed, but without a scene.
+		write_test_mod("loader_test_no_scene", Dictionary({ { "title", "Loader Test No Scene" } }));
+		CHECK(loader->request_mod_scene("loader_test_no_scene") == ERR_FILE_NOT_FOUND);
+		CHECK(loader->get_mod_scene_status("loader_test_no_scene") == QModLoader::SCENE_LOAD_INVALID);
+		CHECK(loader->uninstall_qmod("loader_test_no_scene") == OK);
+		ERR_PRINT_ON;
+	}
+}
+
+} // namespace TestQModLoader
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  test_qmod_store.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../qmod_store.h"
+
+#include "core/io/file_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestQModStore {
+
+TEST_CASE("[Modules][QMod] Blob hashes") {
+	const CharString abc = String("abc").utf8();
+	CHECK(QModStore::hash_buffer((const uint8_t *)abc.get_data(), abc.length()) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+	CHECK(QModStore::hash_buffer(nullptr, 0) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+	String hash = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+	CHECK(QModStore::get_blob_path(hash) == QModStore::get_store_directory() + "/ba/" + hash);
+}
+
+TEST_CASE("[Modules][QMod] Manifest round trip") {
+	String path = TestUtils::get_temp_path("qmod_store_test.manifest");
+
+	QModManifest manifest;
+	manifest.entries.resize(2);
+	manifest.entries[0].path = "mod.json";
+	manifest.entries[0].size = 3;
+	manifest.entries[0].hash = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+	manifest.entries[1].path = "textures/empty.bin";
+	manifest.entries[1].size = 0;
+	manifest.entries[1].hash = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+	REQUIRE(manifest.save(path) == OK);
+
+	QModManifest loaded;
+	REQUIRE(loaded.load(path) == OK);
+	REQUIRE(loaded.entries.size() == 2);
+	for (uint32_t i = 0; i < 2; i++) {
+		CHECK(loaded.entries[i].path == manifest.entries[i].path);
+		CHECK(loaded.entries[i].size == manifest.entries[i].size);
+		CHECK(loaded.entries[i].hash == manifest.entries[i].hash);
+	}
+
+	HashSet<String> hashes;
+	loaded.get_hashes(hashes);
+	CHECK(hashes.size() == 2);
+	CHECK(hashes.has(manifest.entries[0].hash));
+
+	CHECK(loaded.load(TestUtils::get_temp_path("qmod_store_missing.manifest")) != OK);
+}
+
+TEST_CASE("[Modules][QMod] Manifest with a corrupt entry count") {
+	String path = TestUtils::get_temp_path("qmod_store_corrupt.manifest");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_32(QMOD_MANIFEST_MAGIC);
+		f->store_32(QMOD_MANIFEST_VERSION);
+		f->store_32(0xFFFFFFFF);
+	}
+
+	QModManifest manifest;
+	ERR_PRINT_OFF;
+	CHECK(manifest.load(path) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+	CHECK(manifest.entries.is_empty());
+}
+
+TEST_CASE("[Modules][QMod] Manifest with a path outside the mod") {
+	String path = TestUtils::get_temp_path("qmod_store_traversal.manifest");
+
+	QModManifest manifest;
+	manifest.entries.resize(1);
+	manifest.entries[0].path = "../../project.godot";
+	manifest.entries[0].size = 0;
+	manifest.entries[0].hash = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+	REQUIRE(manifest.save(path) == OK);
+
+	QModManifest loaded;
+	ERR_PRINT_OFF;
+	CHECK(loaded.load(path) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+	CHECK(loaded.entries.is_empty());
+}
+
+} // namespace TestQModStore
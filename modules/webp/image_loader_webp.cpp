@@ -47,6 +47,16 @@ Error ImageLoaderWebP::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitFiel
 	Vector<uint8_t> src_image;
 	uint64_t src_image_len = f->get_length();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
+
+	f->set_access_pattern(FileAccess::ACCESS_PATTERN_SEQUENTIAL);
+	const uint8_t *mapped = f->get_mapped_buffer();
+	if (mapped) {
+		// Decode straight from the mapping, starting where the caller left the file (e.g. after a header).
+		const uint64_t position = f->get_position();
+		ERR_FAIL_COND_V(position >= src_image_len, ERR_FILE_CORRUPT);
+		return WebPCommon::webp_load_image_from_buffer(p_image.ptr(), mapped + position, src_image_len - position);
+	}
+
 	src_image.resize(src_image_len);
 
 	uint8_t *w = src_image.ptrw();
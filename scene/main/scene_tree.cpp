@@ -164,6 +164,18 @@ void SceneTree::node_renamed(Node *p_node) {
 	emit_signal(node_renamed_name, p_node);
 }
 
+// Short-lived nodes (e.g. spawned projectiles or pooled instances) sit near the end
+// of group and process lists, so search those backwards when removing.
+static bool _erase_node_from_back(Vector<Node *> &r_nodes, Node *p_node) {
+	for (int i = r_nodes.size() - 1; i >= 0; i--) {
+		if (r_nodes[i] == p_node) {
+			r_nodes.remove_at(i);
+			return true;
+		}
+	}
+	return false;
+}
+
 SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
 	_THREAD_SAFE_METHOD_
 
@@ -184,7 +196,7 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
 	ERR_FAIL_COND(!E);
 
-	E->value.nodes.erase(p_node);
+	_erase_node_from_back(E->value.nodes, p_node);
 	if (E->value.nodes.is_empty()) {
 		group_map.remove(E);
 	}
@@ -1376,12 +1388,12 @@ void SceneTree::_remove_node_from_process_group(Node *p_node, Node *p_owner) {
 	ProcessGroup *pg = p_owner ? (ProcessGroup *)p_owner->data.process_group : &default_process_group;
 
 	if (p_node->is_processing() || p_node->is_processing_internal()) {
-		bool found = pg->nodes.erase(p_node);
+		bool found = _erase_node_from_back(pg->nodes, p_node);
 		ERR_FAIL_COND(!found);
 	}
 
 	if (p_node->is_physics_processing() || p_node->is_physics_processing_internal()) {
-		bool found = pg->physics_nodes.erase(p_node);
+		bool found = _erase_node_from_back(pg->physics_nodes, p_node);
 		ERR_FAIL_COND(!found);
 	}
 }
@@ -191,6 +191,12 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	bool deep_search_warned = false;
 
+	// Editor instantiation keeps going through Object::set(), so that everything it tracks stays accurate.
+	const InstantiationPlan *plan = nullptr;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && !Engine::get_singleton()->is_editor_hint()) {
+		plan = &_get_instantiation_plan();
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
@@ -361,6 +367,13 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 				Dictionary missing_resource_properties;
 				HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_sub_scene; // Record the mappings in the sub-scene.
 
+				// The resolved setters only apply if the node really is of the planned class
+				// (creation may have fallen back to a placeholder or a compatibility class).
+				const InstantiationPlan::NodePlan *node_plan = nullptr;
+				if (plan && node->get_class_name() == plan->nodes[i].type) {
+					node_plan = &plan->nodes[i];
+				}
+
 				for (int j = 0; j < nprop_count; j++) {
 					bool valid;
 
@@ -390,6 +403,21 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 					ERR_FAIL_INDEX_V(nprops[j].name, sname_count, nullptr);
 
+					if (node_plan && node_plan->setters[j].method && !node->get_script_instance()) {
+						// Same call ClassDB::set_property() would make, without the lookups.
+						const InstantiationPlan::Setter &setter = node_plan->setters[j];
+						Callable::CallError ce;
+						if (setter.index >= 0) {
+							Variant index = setter.index;
+							const Variant *args[2] = { &index, &props[nprops[j].value] };
+							setter.method->call(node, args, 2, ce);
+						} else {
+							const Variant *args[1] = { &props[nprops[j].value] };
+							setter.method->call(node, args, 1, ce);
+						}
+						continue;
+					}
+
 					if (snames[nprops[j].name] == CoreStringName(script)) {
 						//work around to avoid old script variables from disappearing, should be the proper fix to:
 						//https://github.com/godotengine/godot/issues/2958
@@ -454,7 +482,11 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 								}
 							}
 
-							value = setup_resources_in_array(set_array, n, resources_local_to_sub_scene, node, snames[nprops[j].name], resources_local_to_scene, i, ret_nodes, p_edit_state);
+							if (plan && !plan->has_local_resources) {
+								value = set_array;
+							} else {
+								value = setup_resources_in_array(set_array, n, resources_local_to_sub_scene, node, snames[nprops[j].name], resources_local_to_scene, i, ret_nodes, p_edit_state);
+							}
 						}
 
 						if (value.get_type() == Variant::DICTIONARY) {
@@ -471,7 +503,11 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 								}
 							}
 
-							value = setup_resources_in_dictionary(set_dict, n, resources_local_to_sub_scene, node, snames[nprops[j].name], resources_local_to_scene, i, ret_nodes, p_edit_state);
+							if (plan && !plan->has_local_resources) {
+								value = set_dict;
+							} else {
+								value = setup_resources_in_dictionary(set_dict, n, resources_local_to_sub_scene, node, snames[nprops[j].name], resources_local_to_scene, i, ret_nodes, p_edit_state);
+							}
 						}
 
 						bool set_valid = true;
@@ -756,6 +792,77 @@ Dictionary SceneState::setup_resources_in_dictionary(Dictionary &p_dictionary_to
 	return p_dictionary_to_scan;
 }
 
+const SceneState::InstantiationPlan &SceneState::_get_instantiation_plan() const {
+	if (instantiation_plan_ready.is_set()) {
+		return instantiation_plan;
+	}
+
+	MutexLock lock(instantiation_plan_mutex);
+	if (instantiation_plan_ready.is_set()) {
+		return instantiation_plan;
+	}
+
+	InstantiationPlan &plan = instantiation_plan;
+	plan.nodes.clear();
+	plan.nodes.resize(nodes.size());
+	plan.has_local_resources = false;
+
+	// Same depth as the checks done while instantiating: the value itself, or the elements of an array or dictionary.
+	for (const Variant &value : variants) {
+		if (value.get_type() == Variant::OBJECT) {
+			Ref<Resource> res = value;
+			plan.has_local_resources = res.is_valid() && res->is_local_to_scene();
+		} else if (value.get_type() == Variant::ARRAY) {
+			plan.has_local_resources = has_local_resource(value);
+		} else if (value.get_type() == Variant::DICTIONARY) {
+			Dictionary dict = value;
+			plan.has_local_resources = has_local_resource(dict.keys()) || has_local_resource(dict.values());
+		}
+		if (plan.has_local_resources) {
+			break;
+		}
+	}
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		if (n.instance >= 0 || n.type == TYPE_INSTANTIATED || (i == 0 && base_scene_idx >= 0)) {
+			continue; // Not created from its class by this scene.
+		}
+		ERR_CONTINUE(n.type < 0 || n.type >= names.size());
+
+		InstantiationPlan::NodePlan &node_plan = plan.nodes[i];
+		node_plan.type = names[n.type];
+		node_plan.setters.resize(n.properties.size());
+
+		for (int j = 0; j < n.properties.size(); j++) {
+			const NodeData::Property &prop = n.properties[j];
+			if ((prop.name & FLAG_PATH_PROPERTY_IS_NODE) || prop.name < 0 || prop.name >= names.size() || prop.value < 0 || prop.value >= variants.size()) {
+				continue;
+			}
+			if (names[prop.name] == CoreStringName(script)) {
+				continue;
+			}
+			// Objects and containers need the local resource and typing fixups done by the regular path.
+			Variant::Type type = variants[prop.value].get_type();
+			if (type == Variant::OBJECT || type == Variant::ARRAY || type == Variant::DICTIONARY) {
+				continue;
+			}
+
+			InstantiationPlan::Setter &setter = node_plan.setters[j];
+			setter.method = ClassDB::get_property_setter_method(node_plan.type, names[prop.name], &setter.index);
+		}
+	}
+
+	instantiation_plan_ready.set();
+	return plan;
+}
+
+void SceneState::_clear_instantiation_plan() {
+	MutexLock lock(instantiation_plan_mutex);
+	instantiation_plan_ready.clear();
+	instantiation_plan = InstantiationPlan();
+}
+
 bool SceneState::has_local_resource(const Array &p_array) const {
 	for (int i = 0; i < p_array.size(); i++) {
 		Ref<Resource> res = p_array[i];
@@ -1437,6 +1544,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_plan();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1634,6 +1742,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 	ERR_FAIL_COND(!p_dictionary.has("conns"));
 	//ERR_FAIL_COND( !p_dictionary.has("path"));
 
+	_clear_instantiation_plan();
+
 	int version = 1;
 	if (p_dictionary.has("version")) {
 		version = p_dictionary["version"];
@@ -2269,11 +2379,13 @@ Vector<Ref<Resource>> SceneState::get_sub_resources() {
 //add
 
 int SceneState::add_name(const StringName &p_name) {
+	_clear_instantiation_plan();
 	names.push_back(p_name);
 	return names.size() - 1;
 }
 
 int SceneState::add_value(const Variant &p_value) {
+	_clear_instantiation_plan();
 	variants.push_back(p_value);
 	return variants.size() - 1;
 }
@@ -2293,6 +2405,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.instance = p_instance;
 	nd.index = p_index;
 
+	_clear_instantiation_plan();
 	nodes.push_back(nd);
 
 	ids.push_back(p_unique_id);
@@ -2311,6 +2424,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 		prop.name |= FLAG_PATH_PROPERTY_IS_NODE;
 	}
 	prop.value = p_value;
+	_clear_instantiation_plan();
 	nodes.write[p_node].properties.push_back(prop);
 }
 
@@ -2322,6 +2436,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instantiation_plan();
 	base_scene_idx = p_idx;
 }
 
@@ -2372,6 +2487,10 @@ bool SceneState::rename_group_references(const StringName &p_old_name, const Str
 			}
 		}
 	}
+	if (edited) {
+		// Names are shared, so this may have renamed a class or property as well.
+		_clear_instantiation_plan();
+	}
 	return edited;
 }
 
@@ -2435,6 +2554,7 @@ SceneState::SceneState() {
 ////////////////
 
 void PackedScene::_set_bundled_scene(const Dictionary &p_scene) {
+	clear_pool();
 	state->set_bundled_scene(p_scene);
 }
 
@@ -2443,10 +2563,12 @@ Dictionary PackedScene::_get_bundled_scene() const {
 }
 
 Error PackedScene::pack(Node *p_scene) {
+	clear_pool();
 	return state->pack(p_scene);
 }
 
 void PackedScene::clear() {
+	clear_pool();
 	state->clear();
 }
 
@@ -2499,7 +2621,235 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+void PackedScene::_prewarm_pool(void *p_userdata) {
+	while (true) {
+		{
+			MutexLock lock(pool.mutex);
+			if (pool.prewarm_pending <= 0) {
+				pool.prewarm_running = false;
+				return;
+			}
+			pool.prewarm_pending--;
+		}
+
+		Node *node = _instantiate_for_pool();
+
+		MutexLock lock(pool.mutex);
+		if (!node) {
+			pool.prewarm_pending = 0;
+			pool.prewarm_running = false;
+			return;
+		}
+		pool.available.push_back(node);
+	}
+}
+
+Node *PackedScene::_instantiate_for_pool() {
+	Node *node = instantiate();
+	if (!node) {
+		return nullptr;
+	}
+
+	{
+		MutexLock lock(pool.mutex);
+		if (pool.defaults_captured) {
+			return node;
+		}
+	}
+
+	// The first instance tells what a pooled node must look like when handed out again.
+	LocalVector<Node *> nodes;
+	_collect_pool_nodes(node, nodes);
+
+	Vector<Pool::NodeDefaults> defaults;
+	defaults.resize(nodes.size());
+	Pool::NodeDefaults *defaults_ptrw = defaults.ptrw();
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		defaults_ptrw[i].type = nodes[i]->get_class_name();
+
+		List<PropertyInfo> properties;
+		nodes[i]->get_property_list(&properties);
+		for (const PropertyInfo &E : properties) {
+			if (!(E.usage & PROPERTY_USAGE_STORAGE)) {
+				continue;
+			}
+			defaults_ptrw[i].properties.push_back(Pair<StringName, Variant>(E.name, nodes[i]->get(E.name).duplicate(true)));
+		}
+	}
+
+	MutexLock lock(pool.mutex);
+	if (!pool.defaults_captured) {
+		pool.defaults = std::move(defaults);
+		pool.defaults_captured = true;
+	}
+	return node;
+}
+
+void PackedScene::_collect_pool_nodes(Node *p_node, LocalVector<Node *> &r_nodes) {
+	r_nodes.push_back(p_node);
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		_collect_pool_nodes(p_node->get_child(i), r_nodes);
+	}
+}
+
+bool PackedScene::_reset_pooled_node(Node *p_node) {
+	if (p_node->is_queued_for_deletion()) {
+		return false;
+	}
+
+	LocalVector<Node *> nodes;
+	_collect_pool_nodes(p_node, nodes);
+
+	// clear_pool() may drop the defaults meanwhile, the snapshot keeps them alive while resetting.
+	Vector<Pool::NodeDefaults> defaults;
+	{
+		MutexLock lock(pool.mutex);
+		defaults = pool.defaults;
+	}
+
+	// Instances whose hierarchy changed since they were handed out are not reused.
+	if (nodes.size() != defaults.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		if (nodes[i]->get_class_name() != defaults[i].type) {
+			return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		for (const Pair<StringName, Variant> &E : defaults[i].properties) {
+			if (nodes[i]->get(E.first) != E.second) {
+				// Copy containers, so the instance doesn't share them with the defaults.
+				nodes[i]->set(E.first, E.second.duplicate(true));
+			}
+		}
+		// The defaults were captured before the instance first entered the tree, so _ready() must run again
+		// for a reused instance to end up like a fresh one.
+		nodes[i]->request_ready();
+	}
+
+	return true;
+}
+
+void PackedScene::prewarm_pool(int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+
+	WorkerThreadPool::TaskID finished_task = WorkerThreadPool::INVALID_TASK_ID;
+	{
+		MutexLock lock(pool.mutex);
+		pool.prewarm_pending += p_count;
+		if (pool.prewarm_running || pool.prewarm_pending == 0) {
+			return;
+		}
+		finished_task = pool.prewarm_task;
+		pool.prewarm_running = true;
+		pool.prewarm_task = WorkerThreadPool::get_singleton()->add_template_task(this, &PackedScene::_prewarm_pool, nullptr, false, vformat("PackedScenePool:%s", get_path()));
+	}
+
+	if (finished_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(finished_task);
+	}
+}
+
+// Must be called with the pool locked.
+void PackedScene::_prune_leased() {
+	if (pool.leased.size() < pool.leased_prune_threshold) {
+		return;
+	}
+
+	LocalVector<ObjectID> freed;
+	for (const ObjectID &id : pool.leased) {
+		if (ObjectDB::get_instance(id) == nullptr) {
+			freed.push_back(id);
+		}
+	}
+	for (const ObjectID &id : freed) {
+		pool.leased.erase(id);
+	}
+
+	// Scan again only once the live leases doubled, so leasing stays constant time on average.
+	pool.leased_prune_threshold = MAX(64u, pool.leased.size() * 2);
+}
+
+Node *PackedScene::instantiate_pooled() {
+	Node *node = nullptr;
+	{
+		MutexLock lock(pool.mutex);
+		if (!pool.available.is_empty()) {
+			node = pool.available[pool.available.size() - 1];
+			pool.available.remove_at(pool.available.size() - 1);
+		}
+	}
+
+	if (!node) {
+		node = _instantiate_for_pool();
+		ERR_FAIL_NULL_V(node, nullptr);
+	}
+
+	MutexLock lock(pool.mutex);
+	pool.leased.insert(node->get_instance_id());
+	_prune_leased();
+	return node;
+}
+
+void PackedScene::release_pooled(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	{
+		MutexLock lock(pool.mutex);
+		ERR_FAIL_COND_MSG(!pool.leased.erase(p_node->get_instance_id()), "Node was not obtained from instantiate_pooled() on this scene.");
+		_prune_leased();
+	}
+
+	Node *parent = p_node->get_parent();
+	if (parent) {
+		parent->remove_child(p_node);
+	}
+
+	if (!_reset_pooled_node(p_node)) {
+		memdelete(p_node);
+		return;
+	}
+
+	MutexLock lock(pool.mutex);
+	pool.available.push_back(p_node);
+}
+
+void PackedScene::clear_pool() {
+	WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+	{
+		MutexLock lock(pool.mutex);
+		pool.prewarm_pending = 0;
+		task = pool.prewarm_task;
+		pool.prewarm_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	if (task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+
+	LocalVector<Node *> available;
+	{
+		MutexLock lock(pool.mutex);
+		available = std::move(pool.available);
+		pool.leased.clear();
+		pool.leased_prune_threshold = 64;
+		pool.defaults.clear();
+		pool.defaults_captured = false;
+	}
+
+	for (Node *node : available) {
+		memdelete(node);
+	}
+}
+
+int PackedScene::get_pooled_count() const {
+	MutexLock lock(pool.mutex);
+	return pool.available.size();
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
+	clear_pool();
 	state = p_by;
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -2508,6 +2858,7 @@ void PackedScene::replace_state(Ref<SceneState> p_by) {
 }
 
 void PackedScene::recreate_state() {
+	clear_pool();
 	state.instantiate();
 	state->set_path(get_path());
 #ifdef TOOLS_ENABLED
@@ -2586,6 +2937,11 @@ void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
+	ClassDB::bind_method(D_METHOD("prewarm_pool", "count"), &PackedScene::prewarm_pool);
+	ClassDB::bind_method(D_METHOD("instantiate_pooled"), &PackedScene::instantiate_pooled);
+	ClassDB::bind_method(D_METHOD("release_pooled", "node"), &PackedScene::release_pooled);
+	ClassDB::bind_method(D_METHOD("clear_pool"), &PackedScene::clear_pool);
+	ClassDB::bind_method(D_METHOD("get_pooled_count"), &PackedScene::get_pooled_count);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
 	ClassDB::bind_method(D_METHOD("get_state"), &PackedScene::get_state);
@@ -2601,3 +2957,7 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 	state.instantiate();
 }
+
+PackedScene::~PackedScene() {
+	clear_pool();
+}
@@ -31,6 +31,12 @@
 #pragma once
 
 #include "core/io/resource.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -90,6 +96,31 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Lookups resolved once and reused by every instantiate() call that doesn't
+	// generate editor state. Built lazily, discarded whenever the state changes.
+	struct InstantiationPlan {
+		struct Setter {
+			MethodBind *method = nullptr; // nullptr means going through Object::set().
+			int index = -1;
+		};
+
+		struct NodePlan {
+			// Only set when the node is created from its class, so the setters apply.
+			StringName type;
+			LocalVector<Setter> setters; // One per NodeData::Property.
+		};
+
+		LocalVector<NodePlan> nodes;
+		bool has_local_resources = false;
+	};
+
+	mutable InstantiationPlan instantiation_plan;
+	mutable SafeFlag instantiation_plan_ready;
+	mutable BinaryMutex instantiation_plan_mutex;
+
+	const InstantiationPlan &_get_instantiation_plan() const;
+	void _clear_instantiation_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map, HashSet<int32_t> &ids_saved);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -247,6 +278,36 @@ class PackedScene : public Resource {
 
 	Ref<SceneState> state;
 
+	// Detached instances handed out by instantiate_pooled() and taken back by release_pooled().
+	struct Pool {
+		struct NodeDefaults {
+			StringName type;
+			LocalVector<Pair<StringName, Variant>> properties;
+		};
+
+		BinaryMutex mutex;
+		LocalVector<Node *> available;
+		// Instances freed by their user instead of released are dropped once this grows past the threshold.
+		HashSet<ObjectID> leased;
+		uint32_t leased_prune_threshold = 64;
+		// Stored properties of a fresh instance, one entry per node in depth-first order.
+		// Copy-on-write, so releases can take a snapshot under the lock and reset nodes outside of it.
+		Vector<NodeDefaults> defaults;
+		bool defaults_captured = false;
+
+		WorkerThreadPool::TaskID prewarm_task = WorkerThreadPool::INVALID_TASK_ID;
+		int prewarm_pending = 0;
+		bool prewarm_running = false;
+	};
+
+	Pool pool;
+
+	void _prewarm_pool(void *p_userdata);
+	Node *_instantiate_for_pool();
+	static void _collect_pool_nodes(Node *p_node, LocalVector<Node *> &r_nodes);
+	bool _reset_pooled_node(Node *p_node);
+	void _prune_leased();
+
 	void _set_bundled_scene(const Dictionary &p_scene);
 	Dictionary _get_bundled_scene() const;
 
@@ -270,6 +331,12 @@ public:
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
+	void prewarm_pool(int p_count);
+	Node *instantiate_pooled();
+	void release_pooled(Node *p_node);
+	void clear_pool();
+	int get_pooled_count() const;
+
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
 
@@ -289,6 +356,7 @@ public:
 	Ref<SceneState> get_state() const;
 
 	PackedScene();
+	~PackedScene();
 };
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/marshalls.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -248,4 +250,46 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Reads after mapping the file") {
+	const String file_path = TestUtils::get_temp_path("file_access_mapped.bin");
+	Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+	REQUIRE(fw.is_valid());
+	for (int i = 0; i < 100; i++) {
+		fw->store_32(i);
+	}
+	fw->close();
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_32() == 0);
+
+	f->set_access_pattern(FileAccess::ACCESS_PATTERN_SEQUENTIAL);
+	const uint8_t *mapped = f->get_mapped_buffer();
+	if (!mapped) {
+		// Not every platform can map files.
+		f.unref();
+		DirAccess::remove_file_or_error(file_path);
+		return;
+	}
+	CHECK(f->get_mapped_buffer() == mapped);
+	CHECK(f->get_length() == 400);
+
+	// Mapping keeps the position, and later reads agree with the view.
+	CHECK(f->get_position() == 4);
+	CHECK(f->get_32() == 1);
+	CHECK(decode_uint32(mapped + 8) == 2);
+	f->seek(396);
+	CHECK(f->get_32() == 99);
+	CHECK_FALSE(f->eof_reached());
+	f->get_8();
+	CHECK(f->eof_reached());
+	CHECK(f->get_error() == ERR_FILE_EOF);
+	f->seek_end(-8);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_32() == 98);
+
+	f.unref();
+	DirAccess::remove_file_or_error(file_path);
+}
+
 } // namespace TestFileAccess
@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  test_file_access_async.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access_async.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestFileAccessAsync {
+
+TEST_CASE("[FileAccessAsync] Batched reads") {
+	FileAccessAsync *local = FileAccessAsync::get_singleton() ? nullptr : memnew(FileAccessAsync(2));
+	FileAccessAsync *async = FileAccessAsync::get_singleton();
+
+	const String path = TestUtils::get_temp_path("file_access_async.bin");
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	for (int i = 0; i < 4096; i++) {
+		f->store_8(i % 251);
+	}
+	f->close();
+
+	uint8_t first[16] = {};
+	uint8_t second[100] = {};
+	uint8_t past_end[32] = {};
+	uint8_t missing[4] = {};
+
+	FileAccessAsync::Read reads[4];
+	reads[0].path = path;
+	reads[0].offset = 0;
+	reads[0].length = sizeof(first);
+	reads[0].buffer = first;
+	reads[1].path = path;
+	reads[1].offset = 3000;
+	reads[1].length = sizeof(second);
+	reads[1].buffer = second;
+	reads[2].path = path;
+	reads[2].offset = 4086;
+	reads[2].length = sizeof(past_end);
+	reads[2].buffer = past_end;
+	reads[3].path = TestUtils::get_temp_path("file_access_async_missing.bin");
+	reads[3].length = sizeof(missing);
+	reads[3].buffer = missing;
+
+	FileAccessAsync::RequestID ids[4];
+	async->submit_batch(reads, 4, ids);
+	for (int i = 0; i < 4; i++) {
+		CHECK(ids[i] != FileAccessAsync::INVALID_REQUEST_ID);
+	}
+
+	uint64_t read = 0;
+	CHECK(async->wait(ids[0], &read) == OK);
+	CHECK(read == sizeof(first));
+	CHECK(first[15] == 15);
+
+	CHECK(async->wait(ids[1], &read) == OK);
+	CHECK(read == sizeof(second));
+	bool matches = true;
+	for (int i = 0; i < 100; i++) {
+		matches = matches && second[i] == (3000 + i) % 251;
+	}
+	CHECK(matches);
+
+	CHECK(async->wait(ids[2], &read) == ERR_FILE_EOF);
+	CHECK(read == 10);
+	CHECK(past_end[9] == 4095 % 251);
+
+	CHECK(async->wait(ids[3]) != OK);
+
+	// Waiting releases the request.
+	ERR_PRINT_OFF;
+	CHECK(async->wait(ids[0]) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+
+	if (local) {
+		memdelete(local);
+	}
+	DirAccess::remove_absolute(path);
+}
+
+} // namespace TestFileAccessAsync
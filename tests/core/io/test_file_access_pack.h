@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  test_file_access_pack.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access_pack.h"
+#include "core/version.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestFileAccessPack {
+
+// Writes a minimal version 3 pack with the given `res://`-relative paths and contents.
+static String write_test_pack(const String &p_name, const Vector<String> &p_paths, const Vector<String> &p_contents) {
+	String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+
+	const uint64_t header_size = 4 * 5 + 4 + 8 + 8 + 16 * 4;
+	uint64_t data_size = 0;
+	for (const String &content : p_contents) {
+		data_size += content.utf8().length();
+	}
+
+	f->store_32(PACK_HEADER_MAGIC);
+	f->store_32(PACK_FORMAT_VERSION_V3);
+	f->store_32(GODOT_VERSION_MAJOR);
+	f->store_32(GODOT_VERSION_MINOR);
+	f->store_32(GODOT_VERSION_PATCH);
+	f->store_32(0); // Pack flags.
+	f->store_64(header_size); // File base.
+	f->store_64(header_size + data_size); // Directory offset.
+	for (int i = 0; i < 16; i++) {
+		f->store_32(0); // Reserved.
+	}
+
+	for (const String &content : p_contents) {
+		CharString cs = content.utf8();
+		f->store_buffer((const uint8_t *)cs.get_data(), cs.length());
+	}
+
+	f->store_32(p_paths.size());
+	uint64_t ofs = 0;
+	for (int i = 0; i < p_paths.size(); i++) {
+		CharString cs = p_paths[i].utf8();
+		f->store_32(cs.length());
+		f->store_buffer((const uint8_t *)cs.get_data(), cs.length());
+		f->store_64(ofs);
+		f->store_64(p_contents[i].utf8().length());
+		for (int j = 0; j < 16; j++) {
+			f->store_8(0); // MD5, not checked on load.
+		}
+		f->store_32(0); // File flags.
+		ofs += p_contents[i].utf8().length();
+	}
+
+	return path;
+}
+
+TEST_CASE("[PackedData] Pack files are readable through FileAccess and DirAccessPack") {
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+
+	String pack = write_test_pack("test_pack_read.pck", { "pack_test/a.txt", "pack_test/sub/b.txt" }, { "hello", "world!" });
+	REQUIRE(PackedData::get_singleton()->add_pack(pack, false, 0) == OK);
+
+	CHECK(FileAccess::exists("res://pack_test/a.txt"));
+	CHECK(FileAccess::get_file_as_string("res://pack_test/a.txt") == "hello");
+
+	Ref<FileAccess> f = FileAccess::open("res://pack_test/sub/b.txt", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == 6);
+	f->seek(3);
+	CHECK(f->get_as_utf8_string() == "ld!");
+	CHECK(f->eof_reached());
+
+	Ref<DirAccess> da = memnew(DirAccessPack);
+	CHECK(da->dir_exists("res://pack_test/sub"));
+	CHECK(da->change_dir("res://pack_test") == OK);
+	CHECK(da->file_exists("a.txt"));
+	CHECK(da->get_directories() == PackedStringArray({ "sub" }));
+	CHECK(da->get_files() == PackedStringArray({ "a.txt" }));
+	CHECK(da->change_dir("missing") != OK);
+
+	PackedData::get_singleton()->remove_pack(pack);
+	CHECK_FALSE(FileAccess::exists("res://pack_test/a.txt"));
+	CHECK_FALSE(da->dir_exists("res://pack_test"));
+
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+}
+
+TEST_CASE("[PackedData] Removing an overlay pack restores the files it replaced") {
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+
+	String base = write_test_pack("test_pack_base.pck", { "pack_test/a.txt" }, { "base" });
+	String overlay = write_test_pack("test_pack_overlay.pck", { "pack_test/a.txt", "pack_test/b.txt" }, { "overlay", "new" });
+
+	REQUIRE(PackedData::get_singleton()->add_pack(base, false, 0) == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(overlay, true, 0) == OK);
+	CHECK(FileAccess::get_file_as_string("res://pack_test/a.txt") == "overlay");
+	CHECK(FileAccess::get_file_as_string("res://pack_test/b.txt") == "new");
+
+	PackedData::get_singleton()->remove_pack(overlay);
+	CHECK(FileAccess::get_file_as_string("res://pack_test/a.txt") == "base");
+	CHECK_FALSE(PackedData::get_singleton()->has_path("res://pack_test/b.txt"));
+
+	PackedData::get_singleton()->remove_pack(base);
+	CHECK_FALSE(PackedData::get_singleton()->has_path("res://pack_test/a.txt"));
+
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+}
+
+} // namespace TestFileAccessPack
@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "core/io/file_access.h"
 #include "core/io/image.h"
+#include "core/io/resource_loader.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -215,6 +217,42 @@ TEST_CASE("[Image] Saving and loading") {
 #endif // MODULE_TGA_ENABLED
 }
 
+static Ref<Image> load_embedded_image(const String &p_name, const String &p_extension, const Vector<uint8_t> &p_data) {
+	// Same layout as the `.image` files written by the image importer: the payload follows a header.
+	const String path = TestUtils::get_temp_path(p_name + ".image");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer((const uint8_t *)"GDIM", 4);
+		f->store_pascal_string(p_extension);
+		f->store_buffer(p_data.ptr(), p_data.size());
+	}
+	return ResourceLoader::load(path, "Image", ResourceFormatLoader::CACHE_MODE_IGNORE);
+}
+
+TEST_CASE("[Image] Loading images stored after a header") {
+	Ref<Image> image = memnew(Image(8, 8, false, Image::FORMAT_RGBA8));
+	image->fill(Color(1, 0.5, 0, 1));
+	image->set_pixel(3, 5, Color(0, 0, 1, 1));
+
+	Ref<Image> image_png = load_embedded_image("embedded_png", "png", image->save_png_to_buffer());
+	REQUIRE(image_png.is_valid());
+	CHECK(image_png->get_size() == image->get_size());
+	CHECK(image_png->get_data() == image->get_data());
+
+#ifdef MODULE_JPG_ENABLED
+	Ref<Image> image_jpg = load_embedded_image("embedded_jpg", "jpg", image->save_jpg_to_buffer());
+	REQUIRE(image_jpg.is_valid());
+	CHECK(image_jpg->get_size() == image->get_size());
+#endif // MODULE_JPG_ENABLED
+
+#ifdef MODULE_WEBP_ENABLED
+	Ref<Image> image_webp = load_embedded_image("embedded_webp", "webp", image->save_webp_to_buffer());
+	REQUIRE(image_webp.is_valid());
+	CHECK(image_webp->get_size() == image->get_size());
+#endif // MODULE_WEBP_ENABLED
+}
+
 TEST_CASE("[Image] Basic getters") {
 	Ref<Image> image = memnew(Image(8, 4, false, Image::FORMAT_LA8));
 	CHECK(image->get_width() == 8);
@@ -0,0 +1,213 @@
+/**************************************************************************/
+/*  test_mod_security.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/mod_security.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "tests/test_macros.h"
+
+namespace TestModSecurity {
+
+TEST_CASE("[ModSecurity] Default policy") {
+	ModSecurity::set_restrictions_enabled(true);
+	ModSecurity::set_mod_context(true);
+
+	CHECK(ModSecurity::is_path_allowed("user://mods/my_mod/level.scn"));
+	CHECK(ModSecurity::is_path_allowed("USER://Mods/my_mod/level.scn"));
+	CHECK(ModSecurity::is_path_allowed("user://mods"));
+	CHECK(ModSecurity::is_path_allowed("user://mods/"));
+	CHECK_FALSE(ModSecurity::is_path_allowed("user://modsfoo"));
+	CHECK_FALSE(ModSecurity::is_path_allowed("user://settings.cfg"));
+	CHECK_FALSE(ModSecurity::is_path_allowed("user://mods/../settings.cfg"));
+	CHECK_FALSE(ModSecurity::is_path_allowed("res://project.godot"));
+	CHECK_FALSE(ModSecurity::is_path_allowed("uid://abc"));
+	CHECK_FALSE(ModSecurity::is_path_allowed("/etc/passwd"));
+	CHECK_FALSE(ModSecurity::is_path_allowed(""));
+
+	ModSecurity::set_mod_context(false);
+	CHECK(ModSecurity::is_path_allowed("res://project.godot"));
+	ModSecurity::set_restrictions_enabled(false);
+}
+
+TEST_CASE("[ModSecurity] Per-mod policy, longest prefix wins") {
+	Ref<ModPathPolicy> policy;
+	policy.instantiate();
+	policy->add_rule("user://mods/a/", ModPathPolicy::RULE_ALLOW);
+	policy->add_rule("user://mods/a/secrets/", ModPathPolicy::RULE_DENY);
+	policy->add_rule("res://shared/", ModPathPolicy::RULE_ALLOW);
+	ModSecurity::set_mod_policy("a", policy);
+
+	ModSecurity::set_restrictions_enabled(true);
+	{
+		ModSecurity::Scope scope(ModSecurity::create_sandbox("a"));
+
+		CHECK(ModSecurity::is_path_allowed("user://mods/a/data.json"));
+		CHECK(ModSecurity::is_path_allowed("res://Shared/Textures/stone.png"));
+		CHECK(ModSecurity::is_path_allowed("user://mods\\a\\data.json"));
+		CHECK_FALSE(ModSecurity::is_path_allowed("user://mods/a/secrets/key.txt"));
+		CHECK_FALSE(ModSecurity::is_path_allowed("user://mods/a/secrets"));
+		CHECK_FALSE(ModSecurity::is_path_allowed("user://mods/b/data.json"));
+		CHECK_FALSE(ModSecurity::is_path_allowed("res://project.godot"));
+	}
+	{
+		// Mods without a policy of their own only get their root.
+		ModSecurity::Scope scope(ModSecurity::create_sandbox("b"));
+		CHECK(ModSecurity::is_path_allowed("user://mods/b/data.json"));
+		CHECK(ModSecurity::is_path_allowed("user://mods/b"));
+		CHECK_FALSE(ModSecurity::is_path_allowed("user://mods/a/data.json"));
+	}
+	CHECK_FALSE(ModSecurity::is_in_mod_context());
+
+	ModSecurity::set_restrictions_enabled(false);
+	ModSecurity::set_mod_policy("a", Ref<ModPathPolicy>());
+	CHECK(ModSecurity::get_mod_policy("a").is_null());
+}
+
+TEST_CASE("[ModSecurity] Sandbox scopes nest and quotas are enforced") {
+	Ref<ModSandbox> outer = ModSecurity::create_sandbox("outer", 100);
+	Ref<ModSandbox> inner = ModSecurity::create_sandbox("inner");
+	REQUIRE(outer.is_valid());
+	CHECK(outer->get_id() != inner->get_id());
+	CHECK(outer->get_root() == "user://mods/outer/");
+
+	{
+		ModSecurity::Scope outer_scope(outer);
+		{
+			ModSecurity::Scope inner_scope(inner);
+			CHECK(ModSecurity::get_current_sandbox() == inner);
+		}
+		CHECK(ModSecurity::get_current_sandbox() == outer);
+	}
+	CHECK(ModSecurity::get_current_sandbox().is_null());
+
+	CHECK(outer->reserve_quota(60));
+	CHECK_FALSE(outer->reserve_quota(60));
+	CHECK(outer->get_quota_used() == 60);
+	outer->release_quota(60);
+	CHECK(outer->reserve_quota(100));
+
+	ERR_PRINT_OFF;
+	CHECK(ModSecurity::create_sandbox("../escape").is_null());
+	ERR_PRINT_ON;
+}
+
+static bool _write_file(const String &p_path, uint64_t p_length) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE);
+	if (f.is_null()) {
+		return false;
+	}
+	Vector<uint8_t> data;
+	data.resize(p_length);
+	data.fill(7);
+	return f->store_buffer(data.ptr(), data.size());
+}
+
+TEST_CASE("[ModSecurity] Rewriting, removing and replacing files credits the quota") {
+	Ref<ModSandbox> sandbox = ModSecurity::create_sandbox("quota_test", 100);
+	REQUIRE(sandbox.is_valid());
+	const String save_path = sandbox->get_root().path_join("save.dat");
+	const String other_path = sandbox->get_root().path_join("other.dat");
+
+	ModSecurity::set_restrictions_enabled(true);
+	{
+		ModSecurity::Scope scope(sandbox);
+		REQUIRE(DirAccess::make_dir_recursive_absolute(sandbox->get_root()) == OK);
+
+		// Overwriting the same save file must not accumulate charges.
+		for (int i = 0; i < 10; i++) {
+			REQUIRE(_write_file(save_path, 60));
+			CHECK(sandbox->get_quota_used() == 60);
+		}
+
+		ERR_PRINT_OFF;
+		CHECK_FALSE(_write_file(other_path, 60));
+		ERR_PRINT_ON;
+
+		// Truncating on open credits the old contents before the new ones are charged.
+		REQUIRE(_write_file(save_path, 30));
+		CHECK(sandbox->get_quota_used() == 30);
+		REQUIRE(_write_file(other_path, 40));
+		CHECK(sandbox->get_quota_used() == 70);
+
+		// Renaming over a file frees the replaced file.
+		CHECK(DirAccess::rename_absolute(other_path, save_path) == OK);
+		CHECK(sandbox->get_quota_used() == 40);
+
+		CHECK(DirAccess::remove_absolute(save_path) == OK);
+		CHECK(sandbox->get_quota_used() == 0);
+
+		DirAccess::remove_absolute(sandbox->get_root());
+	}
+	ModSecurity::set_restrictions_enabled(false);
+}
+
+TEST_CASE("[ModSecurity] Files from earlier runs count against the quota") {
+	const String root = "user://mods/quota_seed_test/";
+	REQUIRE(DirAccess::make_dir_recursive_absolute(root.path_join("saves")) == OK);
+	REQUIRE(_write_file(root.path_join("settings.cfg"), 20));
+	REQUIRE(_write_file(root.path_join("saves/slot_1.dat"), 30));
+
+	Ref<ModSandbox> sandbox = ModSecurity::create_sandbox("quota_seed_test", 100);
+	REQUIRE(sandbox.is_valid());
+	CHECK(sandbox->get_quota_used() == 50);
+	CHECK_FALSE(sandbox->reserve_quota(60));
+	CHECK(sandbox->reserve_quota(50));
+
+	DirAccess::remove_absolute(root.path_join("saves/slot_1.dat"));
+	DirAccess::remove_absolute(root.path_join("saves"));
+	DirAccess::remove_absolute(root.path_join("settings.cfg"));
+	DirAccess::remove_absolute(root);
+}
+
+static void _capture_sandbox_id(void *p_userdata) {
+	const Ref<ModSandbox> &sandbox = ModSecurity::get_current_sandbox();
+	*(uint32_t *)p_userdata = sandbox.is_valid() ? sandbox->get_id() : 0;
+}
+
+TEST_CASE("[ModSecurity] Sandbox follows WorkerThreadPool tasks") {
+	Ref<ModSandbox> sandbox = ModSecurity::create_sandbox("worker");
+	uint32_t seen_id = 0;
+	{
+		ModSecurity::Scope scope(sandbox);
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&_capture_sandbox_id, &seen_id);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+	CHECK(seen_id == sandbox->get_id());
+
+	uint32_t outside_id = 1;
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task(&_capture_sandbox_id, &outside_id);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	CHECK(outside_id == 0);
+}
+
+} // namespace TestModSecurity
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -573,6 +574,134 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Packed arrays in binary resources") {
+	PackedByteArray bytes;
+	PackedInt64Array ints;
+	PackedFloat32Array floats;
+	PackedVector3Array vectors;
+	PackedColorArray colors;
+	for (int i = 0; i < 10000; i++) {
+		bytes.push_back(i & 0xFF);
+		ints.push_back(int64_t(i) << 32);
+		floats.push_back(i * 0.5f);
+		vectors.push_back(Vector3(i, -i, i * 2));
+		colors.push_back(Color(i / 10000.0f, 0, 1, 0.5));
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	resource->set_meta("ints", ints);
+	resource->set_meta("floats", floats);
+	resource->set_meta("vectors", vectors);
+	resource->set_meta("colors", colors);
+	const String save_path = TestUtils::get_temp_path("packed_arrays.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	Ref<Resource> loaded = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	CHECK(PackedByteArray(loaded->get_meta("bytes")) == bytes);
+	CHECK(PackedInt64Array(loaded->get_meta("ints")) == ints);
+	CHECK(PackedFloat32Array(loaded->get_meta("floats")) == floats);
+	CHECK(PackedVector3Array(loaded->get_meta("vectors")) == vectors);
+	CHECK(PackedColorArray(loaded->get_meta("colors")) == colors);
+
+	SUBCASE("Truncated payloads are rejected") {
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(save_path);
+		REQUIRE(data.size() > 1024);
+		const String truncated_path = TestUtils::get_temp_path("packed_arrays_truncated.res");
+		{
+			Ref<FileAccess> f = FileAccess::open(truncated_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_buffer(data.ptr(), data.size() / 2);
+		}
+
+		ERR_PRINT_OFF;
+		Ref<Resource> truncated = ResourceLoader::load(truncated_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		ERR_PRINT_ON;
+		CHECK(truncated.is_null());
+	}
+}
+
+TEST_CASE("[Resource] Loading many sub-resources with sub-threads") {
+	Ref<Resource> shared = memnew(Resource);
+	shared->set_name("Shared");
+
+	Array children;
+	for (int i = 0; i < 32; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedFloat32Array values;
+		for (int j = 0; j < 256; j++) {
+			values.push_back(i * j);
+		}
+		child->set_meta("values", values);
+		child->set_meta("shared", shared);
+		// Nested, so decoding a child also decodes a sub-resource of its own.
+		Ref<Resource> detail = memnew(Resource);
+		detail->set_name(vformat("Detail %d", i));
+		detail->set_meta("id", i);
+		child->set_meta("detail", detail);
+		if (i % 2 == 1) {
+			// Chain half of them, so they have to wait for the previous one.
+			child->set_meta("previous", children[i - 1]);
+		}
+		children.push_back(child);
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("children", children);
+	const String save_path = TestUtils::get_temp_path("sub_resources.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	// Well above the threshold for decoding sub-resources on worker tasks, with many independent
+	// sub-resources on each dependency level, so the threaded path is taken.
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	Ref<Resource> loaded = ResourceLoader::load_threaded_get(save_path);
+	REQUIRE(loaded.is_valid());
+
+	Array loaded_children = loaded->get_meta("children");
+	REQUIRE(loaded_children.size() == children.size());
+	Ref<Resource> loaded_shared;
+	for (int i = 0; i < loaded_children.size(); i++) {
+		Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		CHECK(PackedFloat32Array(child->get_meta("values")) == PackedFloat32Array(Ref<Resource>(children[i])->get_meta("values")));
+
+		// References between sub-resources must resolve to the same instances.
+		if (i == 0) {
+			loaded_shared = child->get_meta("shared");
+			REQUIRE(loaded_shared.is_valid());
+			CHECK(loaded_shared->get_name() == "Shared");
+		} else {
+			CHECK(Ref<Resource>(child->get_meta("shared")) == loaded_shared);
+		}
+		if (i % 2 == 1) {
+			CHECK(Ref<Resource>(child->get_meta("previous")) == Ref<Resource>(loaded_children[i - 1]));
+		} else {
+			CHECK_FALSE(child->has_meta("previous"));
+		}
+
+		Ref<Resource> detail = child->get_meta("detail");
+		REQUIRE(detail.is_valid());
+		CHECK(detail->get_name() == vformat("Detail %d", i));
+		CHECK(int(detail->get_meta("id")) == i);
+	}
+
+	// Decoded the same as on the serial path.
+	Ref<Resource> serial = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(serial.is_valid());
+	Array serial_children = serial->get_meta("children");
+	REQUIRE(serial_children.size() == loaded_children.size());
+	for (int i = 0; i < serial_children.size(); i++) {
+		Ref<Resource> serial_child = serial_children[i];
+		Ref<Resource> child = loaded_children[i];
+		CHECK(serial_child->get_name() == child->get_name());
+		CHECK(PackedFloat32Array(serial_child->get_meta("values")) == PackedFloat32Array(child->get_meta("values")));
+		CHECK(Ref<Resource>(serial_child->get_meta("detail"))->get_name() == Ref<Resource>(child->get_meta("detail"))->get_name());
+	}
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
@@ -889,5 +889,25 @@ TEST_SUITE("[ClassDB]") {
 			}
 		}
 	}
+
+	TEST_CASE("[ClassDB] Method lookups") {
+		const StringName object_class = "Object";
+		const StringName ref_counted_class = "RefCounted";
+		const StringName get_class_method = "get_class";
+		const StringName init_ref_method = "init_ref";
+		const StringName nonexistent_method = "nonexistent_method";
+
+		// Repeated, so later lookups are served from the cache.
+		for (int i = 0; i < 2; i++) {
+			MethodBind *get_class = ClassDB::get_method(object_class, get_class_method);
+			REQUIRE(get_class != nullptr);
+			CHECK(get_class->get_name() == get_class_method);
+			CHECK(ClassDB::get_method(ref_counted_class, get_class_method) == get_class);
+
+			CHECK(ClassDB::get_method(ref_counted_class, init_ref_method) != nullptr);
+			CHECK(ClassDB::get_method(object_class, init_ref_method) == nullptr);
+			CHECK(ClassDB::get_method(object_class, nonexistent_method) == nullptr);
+		}
+	}
 }
 } // namespace TestClassDB
@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/callable_method_pointer.h"
+#include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+static LocalVector<int> calls;
+static BinaryMutex calls_mutex;
+
+static void record_call(int p_value) {
+	MutexLock lock(calls_mutex);
+	calls.push_back(p_value);
+}
+
+TEST_CASE("[CallQueue] Flushes in push order") {
+	CallQueue queue;
+	calls.clear();
+
+	for (int i = 0; i < 1000; i++) {
+		queue.push_callable(callable_mp_static(&record_call), i);
+	}
+	CHECK(queue.has_messages());
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(calls.size() == 1000);
+
+	bool in_order = true;
+	for (int i = 0; i < 1000; i++) {
+		in_order = in_order && calls[i] == i;
+	}
+	CHECK(in_order);
+
+	queue.push_callable(callable_mp_static(&record_call), -1);
+	queue.clear();
+	CHECK_FALSE(queue.has_messages());
+	CHECK(queue.flush() == OK);
+	CHECK(calls.size() == 1000);
+}
+
+struct ThreadedPushes {
+	static const int PUSHES = 1000;
+
+	CallQueue *queue = nullptr;
+
+	void run(uint32_t p_index, void *p_userdata) {
+		for (int i = 0; i < PUSHES; i++) {
+			queue->push_callable(callable_mp_static(&record_call), int(p_index * PUSHES + i));
+		}
+	}
+};
+
+TEST_CASE("[CallQueue] Pushes from several threads") {
+	CallQueue queue;
+	calls.clear();
+
+	SUBCASE("Messages pushed after others were flushed are flushed after them") {
+		queue.push_callable(callable_mp_static(&record_call), 0);
+		ThreadedPushes pushes;
+		pushes.queue = &queue;
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&pushes, &ThreadedPushes::run, nullptr, 1);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		queue.push_callable(callable_mp_static(&record_call), -1);
+
+		CHECK(queue.flush() == OK);
+		REQUIRE(calls.size() == ThreadedPushes::PUSHES + 2);
+		CHECK(calls[0] == 0);
+		CHECK(calls[ThreadedPushes::PUSHES + 1] == -1);
+	}
+
+	SUBCASE("The messages of each thread are flushed in order") {
+		const int threads = 16;
+		ThreadedPushes pushes;
+		pushes.queue = &queue;
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&pushes, &ThreadedPushes::run, nullptr, threads);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		CHECK(queue.flush() == OK);
+		REQUIRE(calls.size() == threads * ThreadedPushes::PUSHES);
+
+		int last[threads];
+		for (int i = 0; i < threads; i++) {
+			last[i] = -1;
+		}
+		bool in_order = true;
+		for (int value : calls) {
+			int thread = value / ThreadedPushes::PUSHES;
+			in_order = in_order && value > last[thread];
+			last[thread] = value;
+		}
+		CHECK(in_order);
+	}
+
+	CHECK_FALSE(queue.has_messages());
+}
+
+#ifdef THREADS_ENABLED
+static const int FLUSH_PUSHES = 100000;
+static const int FLUSH_MAX_PENDING = 64;
+
+static std::atomic<int> pending_pushes;
+static std::atomic<int> flushed_pushes;
+static std::atomic<int> failed_pushes;
+
+static void flush_push() {
+	pending_pushes.fetch_sub(1);
+	flushed_pushes.fetch_add(1);
+}
+
+static void push_during_flushes(void *p_userdata) {
+	CallQueue *queue = static_cast<CallQueue *>(p_userdata);
+	for (int i = 0; i < FLUSH_PUSHES; i++) {
+		while (pending_pushes.load() >= FLUSH_MAX_PENDING) {
+			Thread::yield();
+		}
+		pending_pushes.fetch_add(1);
+		if (queue->push_callable(callable_mp_static(&flush_push)) != OK) {
+			pending_pushes.fetch_sub(1);
+			failed_pushes.fetch_add(1);
+		}
+	}
+}
+
+TEST_CASE("[CallQueue] Flushed pages are reused while another thread keeps pushing") {
+	// Few pages, but far more messages than they hold are pushed while flushing.
+	CallQueue queue(nullptr, 4);
+	pending_pushes.store(0);
+	flushed_pushes.store(0);
+	failed_pushes.store(0);
+
+	Thread thread;
+	thread.start(&push_during_flushes, &queue);
+	while (flushed_pushes.load() + failed_pushes.load() < FLUSH_PUSHES) {
+		queue.flush();
+	}
+	thread.wait_to_finish();
+
+	CHECK(failed_pushes.load() == 0);
+	CHECK(flushed_pushes.load() == FLUSH_PUSHES);
+	CHECK_FALSE(queue.has_messages());
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestMessageQueue
@@ -33,6 +33,9 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 
 #include "tests/test_macros.h"
 
@@ -316,6 +319,13 @@ TEST_CASE("[Object] Absent name getter") {
 			"The returned value should equal nil variant.");
 }
 
+struct SignalOrderRecorder : public Object {
+	int id = 0;
+	LocalVector<int> *order = nullptr;
+
+	void record() { order->push_back(id); }
+};
+
 TEST_CASE("[Object] Signals") {
 	Object object;
 
@@ -455,6 +465,65 @@ TEST_CASE("[Object] Signals") {
 		object.get_all_signal_connections(&signal_connections);
 		CHECK(signal_connections.size() == 0);
 	}
+
+	SUBCASE("Disconnecting should keep the remaining connections in order") {
+		LocalVector<int> order;
+		SignalOrderRecorder recorders[16];
+		for (int i = 0; i < 16; i++) {
+			recorders[i].id = i;
+			recorders[i].order = &order;
+			object.connect("my_custom_signal", callable_mp(&recorders[i], &SignalOrderRecorder::record));
+		}
+
+		// Enough disconnections to compact the connections once.
+		for (int i = 1; i < 16; i += 2) {
+			object.disconnect("my_custom_signal", callable_mp(&recorders[i], &SignalOrderRecorder::record));
+		}
+		object.disconnect("my_custom_signal", callable_mp(&recorders[4], &SignalOrderRecorder::record));
+		object.connect("my_custom_signal", callable_mp(&recorders[1], &SignalOrderRecorder::record));
+
+		CHECK(object.emit_signal("my_custom_signal") == OK);
+		const int expected[] = { 0, 2, 6, 8, 10, 12, 14, 1 };
+		REQUIRE(order.size() == 8);
+		for (uint32_t i = 0; i < order.size(); i++) {
+			CHECK(order[i] == expected[i]);
+		}
+
+		// Connections moved by the compaction can still be disconnected.
+		for (int i : expected) {
+			object.disconnect("my_custom_signal", callable_mp(&recorders[i], &SignalOrderRecorder::record));
+		}
+		List<Object::Connection> signal_connections;
+		object.get_all_signal_connections(&signal_connections);
+		CHECK(signal_connections.size() == 0);
+	}
+
+	SUBCASE("Emitting a signal connected to native methods should call them") {
+		object.add_user_signal(MethodInfo("toggled", PropertyInfo(Variant::BOOL, "toggled_on")));
+		Object target;
+		Object one_shot_target;
+		object.connect("toggled", Callable(&target, "set_block_signals"));
+		object.connect("toggled", Callable(&one_shot_target, "set_block_signals"), Object::CONNECT_ONE_SHOT);
+
+		// Exact argument types.
+		CHECK(object.emit_signal("toggled", true) == OK);
+		CHECK(target.is_blocking_signals());
+		CHECK(one_shot_target.is_blocking_signals());
+		CHECK_FALSE(object.is_connected("toggled", Callable(&one_shot_target, "set_block_signals")));
+
+		// Arguments needing conversion.
+		CHECK(object.emit_signal("toggled", 0) == OK);
+		CHECK_FALSE(target.is_blocking_signals());
+		CHECK(one_shot_target.is_blocking_signals());
+
+		ERR_PRINT_OFF;
+		CHECK(object.emit_signal("toggled") == ERR_METHOD_NOT_FOUND);
+		ERR_PRINT_ON;
+
+		object.disconnect("toggled", Callable(&target, "set_block_signals"));
+		CHECK(object.emit_signal("toggled", true) == OK);
+		CHECK_FALSE(target.is_blocking_signals());
+	}
 }
 
 class NotificationObjectSuperclass : public Object {
@@ -620,4 +689,58 @@ TEST_CASE("[Object] RequiredParam Ref<T>") {
 	CHECK_EQ(ref->get_reference_count(), extract->get_reference_count());
 }
 
+#ifdef THREADS_ENABLED
+TEST_CASE("[Object] Concurrent ObjectDB lookups") {
+	struct LookupData {
+		LocalVector<ObjectID> kept;
+		std::atomic<uint32_t> failures = 0;
+	} data;
+
+	LocalVector<Object *> objects;
+	for (int i = 0; i < 64; i++) {
+		objects.push_back(memnew(Object));
+		data.kept.push_back(objects[i]->get_instance_id());
+	}
+
+	TightLocalVector<Thread> threads;
+	threads.resize(MAX(2, OS::get_singleton()->get_processor_count()));
+	for (Thread &thread : threads) {
+		thread.start(
+				[](void *p_data) {
+					LookupData *data = (LookupData *)p_data;
+					uint32_t failures = 0;
+					for (uint32_t i = 0; i < 500; i++) {
+						// Objects created and freed here grow and reuse slots while the kept ones are looked up.
+						Object *temp = memnew(Object);
+						ObjectID temp_id = temp->get_instance_id();
+						if (ObjectDB::get_instance(temp_id) != temp) {
+							failures++;
+						}
+						memdelete(temp);
+						if (ObjectDB::get_instance(temp_id) != nullptr) {
+							failures++;
+						}
+
+						ObjectID id = data->kept[i % data->kept.size()];
+						Object *obj = ObjectDB::get_instance(id);
+						if (obj == nullptr || obj->get_instance_id() != id) {
+							failures++;
+						}
+					}
+					data->failures.fetch_add(failures);
+				},
+				&data);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+	CHECK(data.failures.load() == 0);
+
+	for (uint32_t i = 0; i < objects.size(); i++) {
+		memdelete(objects[i]);
+		CHECK(ObjectDB::get_instance(data.kept[i]) == nullptr);
+	}
+}
+#endif // THREADS_ENABLED
+
 } // namespace TestObject
@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+static bool check_pattern(const uint8_t *p_mem, size_t p_size, uint8_t p_seed) {
+	for (size_t i = 0; i < p_size; i++) {
+		if (p_mem[i] != (uint8_t)(p_seed + i)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void fill_pattern(uint8_t *p_mem, size_t p_size, uint8_t p_seed) {
+	for (size_t i = 0; i < p_size; i++) {
+		p_mem[i] = p_seed + i;
+	}
+}
+
+TEST_CASE("[Memory] Reallocation keeps contents across sizes") {
+	// Grows and shrinks through small and large sizes, so blocks move between allocators
+	// when the small object allocator is enabled.
+	const size_t sizes[] = { 1, 16, 17, 200, 256, 257, 1000, 1024, 1025, 5000, 300, 8, 70000, 40 };
+
+	uint8_t *mem = (uint8_t *)memalloc(sizes[0]);
+	fill_pattern(mem, sizes[0], 7);
+	size_t prev_size = sizes[0];
+
+	bool all_kept = true;
+	for (size_t i = 1; i < std::size(sizes); i++) {
+		mem = (uint8_t *)memrealloc(mem, sizes[i]);
+		REQUIRE(mem);
+		all_kept = all_kept && check_pattern(mem, MIN(prev_size, sizes[i]), 7);
+		fill_pattern(mem, sizes[i], 7);
+		prev_size = sizes[i];
+	}
+	CHECK(all_kept);
+	memfree(mem);
+}
+
+TEST_CASE("[Memory] Zeroed allocations") {
+	// Reuse freed blocks that were dirtied first.
+	for (size_t size : { 24, 512, 4096 }) {
+		uint8_t *dirty = (uint8_t *)memalloc(size);
+		memset(dirty, 0xAB, size);
+		memfree(dirty);
+
+		uint8_t *mem = (uint8_t *)memalloc_zeroed(size);
+		bool all_zero = true;
+		for (size_t i = 0; i < size; i++) {
+			all_zero = all_zero && mem[i] == 0;
+		}
+		CHECK(all_zero);
+		memfree(mem);
+	}
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Memory] Usage accounting") {
+	const uint64_t before = Memory::get_mem_usage();
+
+	void *small = memalloc(100);
+	void *large = memalloc(100000);
+	CHECK(Memory::get_mem_usage() == before + 100 + 100000);
+	CHECK(Memory::get_mem_max_usage() >= before + 100 + 100000);
+
+	small = memrealloc(small, 600);
+	CHECK(Memory::get_mem_usage() == before + 600 + 100000);
+
+	memfree(small);
+	memfree(large);
+	CHECK(Memory::get_mem_usage() == before);
+}
+#endif
+
+} // namespace TestMemory
@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+	CHECK(a != StringName("test_string_name_interning_other"));
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Names are recreated after being freed") {
+	for (int i = 0; i < 100; i++) {
+		const String name = "test_string_name_recreated_" + itos(i % 10);
+		StringName first = name;
+		CHECK(String(first) == name);
+		first = StringName();
+
+		const StringName second = name;
+		CHECK(String(second) == name);
+		CHECK(second == StringName(name));
+	}
+}
+
+#ifdef THREADS_ENABLED
+TEST_CASE("[StringName] Concurrent creation and destruction") {
+	const int name_count = 64;
+	// Every other name stays alive, so lookups of existing entries race with creation of new ones.
+	LocalVector<StringName> kept;
+	for (int i = 0; i < name_count; i += 2) {
+		kept.push_back(StringName("test_string_name_concurrent_" + itos(i)));
+	}
+
+	struct Worker {
+		Thread thread;
+		int index = 0;
+		int mismatches = 0;
+	};
+	LocalVector<Worker> workers;
+	workers.resize(MAX(2, OS::get_singleton()->get_processor_count()));
+	for (uint32_t i = 0; i < workers.size(); i++) {
+		workers[i].index = i;
+		workers[i].thread.start(
+				[](void *p_data) {
+					Worker *worker = (Worker *)p_data;
+					for (int j = 0; j < 2000; j++) {
+						const String name = "test_string_name_concurrent_" + itos((worker->index * 7 + j) % name_count);
+						const StringName sn = name;
+						if (String(sn) != name || sn != StringName(name)) {
+							worker->mismatches++;
+						}
+					}
+				},
+				&workers[i]);
+	}
+
+	int mismatches = 0;
+	for (Worker &worker : workers) {
+		worker.thread.wait_to_finish();
+		mismatches += worker.mismatches;
+	}
+	CHECK(mismatches == 0);
+	for (const StringName &name : kept) {
+		CHECK(name.data_unique_pointer() == StringName(String(name)).data_unique_pointer());
+	}
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestStringName
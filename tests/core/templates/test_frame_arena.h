@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/frame_arena.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rb_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+template <typename T>
+using FrameVector = LocalVector<T, uint32_t, false, false, FrameArena>;
+
+TEST_CASE("[FrameArena] Allocation alignment and usage") {
+	FrameArena arena;
+
+	CHECK(arena.get_usage() == 0);
+	for (size_t size : { 1, 3, 17, 100, 4096 }) {
+		void *ptr = arena.allocate(size);
+		CHECK(ptr != nullptr);
+		CHECK((size_t)ptr % FrameArena::ALIGNMENT == 0);
+	}
+	CHECK(arena.get_usage() >= 1 + 3 + 17 + 100 + 4096);
+
+	// Larger than a block.
+	uint8_t *big = (uint8_t *)arena.allocate(FrameArena::BLOCK_SIZE * 2);
+	memset(big, 0xAB, FrameArena::BLOCK_SIZE * 2);
+	CHECK(big[FrameArena::BLOCK_SIZE * 2 - 1] == 0xAB);
+
+	arena.advance_frame();
+	CHECK(arena.get_usage() == 0);
+}
+
+TEST_CASE("[FrameArena] Reallocation") {
+	FrameArena arena;
+
+	// The latest allocation grows in place.
+	uint32_t *a = (uint32_t *)arena.allocate(sizeof(uint32_t) * 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		a[i] = i;
+	}
+	uint32_t *grown = (uint32_t *)arena.reallocate(a, sizeof(uint32_t) * 4, sizeof(uint32_t) * 64);
+	CHECK(grown == a);
+
+	// Anything else is copied.
+	arena.allocate(16);
+	uint32_t *moved = (uint32_t *)arena.reallocate(grown, sizeof(uint32_t) * 64, sizeof(uint32_t) * 128);
+	CHECK(moved != grown);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(moved[i] == i);
+	}
+}
+
+TEST_CASE("[FrameArena] Memory is recycled two frames later") {
+	FrameArena arena;
+
+	uint8_t *first = (uint8_t *)arena.allocate(64);
+	memset(first, 0x5A, 64);
+
+	arena.advance_frame();
+	uint8_t *second = (uint8_t *)arena.allocate(64);
+	CHECK(second != first);
+	// Allocations from the previous frame are still intact.
+	CHECK(first[0] == 0x5A);
+	CHECK(first[63] == 0x5A);
+
+	arena.advance_frame();
+	uint8_t *third = (uint8_t *)arena.allocate(64);
+	CHECK(third == first);
+
+	arena.release_memory();
+	CHECK(arena.get_usage() == 0);
+}
+
+TEST_CASE("[FrameArena] Containers") {
+	// Uses the arena of this thread, without advancing or releasing it, as other users may share it.
+	FrameVector<String> strings;
+	for (int i = 0; i < 1000; i++) {
+		strings.push_back(itos(i));
+	}
+	CHECK(strings.size() == 1000);
+	CHECK(strings[0] == "0");
+	CHECK(strings[999] == "999");
+	strings.reset();
+
+	RBMap<int, int, Comparator<int>, FrameArena> map;
+	for (int i = 0; i < 100; i++) {
+		map[i] = i * 2;
+	}
+	CHECK(map.size() == 100);
+	CHECK(map[50] == 100);
+	map.erase(50);
+	CHECK(!map.has(50));
+
+	HashMap<int, String, HashMapHasherDefault, HashMapComparatorDefault<int>, FrameArenaTypedAllocator<HashMapElement<int, String>>> hash_map;
+	for (int i = 0; i < 100; i++) {
+		hash_map.insert(i, itos(i));
+	}
+	CHECK(hash_map.size() == 100);
+	CHECK(hash_map[42] == "42");
+	hash_map.erase(42);
+	CHECK(!hash_map.has(42));
+	hash_map.clear();
+}
+
+} //namespace TestFrameArena
@@ -253,4 +253,110 @@ TEST_CASE("[RID_Owner] Thread safety") {
 }
 #endif // THREADS_ENABLED
 
+TEST_CASE("[RID_Owner] Sharded allocation") {
+	RID_Owner<int, true, true> owner(sizeof(int) * 4);
+
+	LocalVector<RID> rids;
+	for (int i = 0; i < 100; i++) {
+		rids.push_back(owner.make_rid(i));
+	}
+	CHECK(owner.get_rid_count() == 100);
+	CHECK(owner.get_owned_list().size() == 100);
+
+	bool all_found = true;
+	for (int i = 0; i < 100; i++) {
+		int *value = owner.get_or_null(rids[i]);
+		all_found = all_found && value && *value == i && owner.owns(rids[i]);
+	}
+	CHECK(all_found);
+
+	RID freed = rids[10];
+	owner.free(freed);
+	CHECK(owner.get_or_null(freed) == nullptr);
+	CHECK_FALSE(owner.owns(freed));
+
+	// The freed index is reused, but with a new validator.
+	RID reused = owner.make_rid(1000);
+	CHECK((reused.get_id() & 0xFFFFFFFF) == (freed.get_id() & 0xFFFFFFFF));
+	CHECK(reused != freed);
+	CHECK(owner.get_or_null(freed) == nullptr);
+	CHECK(*owner.get_or_null(reused) == 1000);
+	rids[10] = reused;
+
+	for (const RID &rid : rids) {
+		owner.free(rid);
+	}
+	CHECK(owner.get_rid_count() == 0);
+	CHECK(owner.get_owned_list().is_empty());
+}
+
+#ifdef THREADS_ENABLED
+// Every thread churns through RIDs of its own while looking up ones shared by all of them,
+// so allocations from different shards interleave with lookups across shards.
+TEST_CASE("[RID_Owner] Sharded allocation across threads") {
+	static const uint32_t ITERATIONS = 2000;
+
+	struct ShardedChurnTester {
+		RID_Owner<int, true, true> rid_owner{ sizeof(int) * 64 };
+		TightLocalVector<Thread> threads;
+		LocalVector<RID> shared_rids;
+		SafeNumeric<uint32_t> next_thread_idx;
+		std::atomic<uint32_t> correct = 0;
+
+		ShardedChurnTester() {
+			threads.resize(OS::get_singleton()->get_processor_count());
+			for (int i = 0; i < 64; i++) {
+				shared_rids.push_back(rid_owner.make_rid(i));
+			}
+		}
+
+		~ShardedChurnTester() {
+			for (const RID &rid : shared_rids) {
+				rid_owner.free(rid);
+			}
+		}
+
+		void test() {
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				threads[i].start(
+						[](void *p_data) {
+							ShardedChurnTester *sct = (ShardedChurnTester *)p_data;
+							int self_th_idx = sct->next_thread_idx.postincrement();
+
+							uint32_t local_correct = 0;
+							for (uint32_t j = 0; j < ITERATIONS; j++) {
+								RID rid = sct->rid_owner.make_rid(self_th_idx);
+								int *value = sct->rid_owner.get_or_null(rid);
+								bool ok = value && *value == self_th_idx;
+
+								uint32_t shared_idx = (self_th_idx + j) % sct->shared_rids.size();
+								value = sct->rid_owner.get_or_null(sct->shared_rids[shared_idx]);
+								ok = ok && value && *value == int(shared_idx);
+
+								sct->rid_owner.free(rid);
+								ok = ok && sct->rid_owner.get_or_null(rid) == nullptr;
+								if (ok) {
+									local_correct++;
+								}
+							}
+
+							sct->correct.fetch_add(local_correct, std::memory_order_acq_rel);
+						},
+						this);
+			}
+
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				threads[i].wait_to_finish();
+			}
+
+			CHECK_EQ(correct.load(), threads.size() * ITERATIONS);
+			CHECK_EQ(rid_owner.get_rid_count(), shared_rids.size());
+		}
+	};
+
+	ShardedChurnTester tester;
+	tester.test();
+}
+#endif // THREADS_ENABLED
+
 } // namespace TestRID
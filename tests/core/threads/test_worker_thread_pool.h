@@ -172,4 +172,105 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_stealing_leaf(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+static void static_stealing_task(void *p_arg) {
+	// Posted from a pool thread, so these go to its local queue for other threads to steal.
+	WorkerThreadPool *pool = (WorkerThreadPool *)p_arg;
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(static_stealing_leaf, nullptr, counter.size(), -1, true);
+	pool->wait_for_group_task_completion(group);
+
+	WorkerThreadPool::TaskID task = pool->add_native_task(static_test, (void *)(uintptr_t)0, true);
+	pool->wait_for_task_completion(task);
+}
+
+TEST_CASE("[WorkerThreadPool] Nested tasks on a work stealing pool") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_named_pool(SNAME("WorkStealingTest"), WorkerThreadPool::SCHEDULER_WORK_STEALING);
+	CHECK(pool->get_scheduler() == WorkerThreadPool::SCHEDULER_WORK_STEALING);
+
+	// Asking for the same pool with another scheduler warns and keeps the existing one.
+	ERR_PRINT_OFF;
+	CHECK(WorkerThreadPool::get_named_pool(SNAME("WorkStealingTest"), WorkerThreadPool::SCHEDULER_SHARED_QUEUE) == pool);
+	ERR_PRINT_ON;
+	CHECK(pool->get_scheduler() == WorkerThreadPool::SCHEDULER_WORK_STEALING);
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(1.0f, 8.0f));
+		const int outer = Math::pow(2.0f, Math::random(0.0f, 4.0f));
+
+		counter.clear();
+		counter.resize(count);
+
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		for (int i = 0; i < outer; i++) {
+			tasks.push_back(pool->add_native_task(static_stealing_task, pool, true));
+		}
+		for (uint32_t i = 0; i < tasks.size(); i++) {
+			CHECK(pool->wait_for_task_completion(tasks[i]) == OK);
+		}
+
+		bool all_run = counter[0].get() == outer * 4; // One from the group, three from static_test().
+		for (int i = 1; i < count; i++) {
+			//Reduce number of check messages
+			all_run &= counter[i].get() == outer;
+		}
+		CHECK(all_run);
+	}
+}
+
+static SafeNumeric<int> dependency_stage;
+static SafeFlag dependency_order_broken;
+
+static void static_dependency_first(void *p_arg) {
+	OS::get_singleton()->delay_usec(1000); // Give dependents a chance to run too early.
+	dependency_stage.set(1);
+}
+
+static void static_dependency_group(void *p_arg, uint32_t p_index) {
+	if (dependency_stage.get() != 1) {
+		dependency_order_broken.set();
+	}
+	counter[p_index].increment();
+}
+
+static void static_dependency_last(void *p_arg) {
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		if (counter[i].get() != 1) {
+			dependency_order_broken.set();
+		}
+	}
+	dependency_stage.set(2);
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks and groups with dependencies") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 6.0f));
+
+		counter.clear();
+		counter.resize(count);
+		dependency_stage.set(0);
+		dependency_order_broken.clear();
+
+		WorkerThreadPool::TaskID first = pool->add_native_task(static_dependency_first, nullptr, true);
+		WorkerThreadPool::TaskID first_deps[] = { first };
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_dependency_group, nullptr, count, -1, true, String(), first_deps);
+		// Also depends on an empty group, which must still wait for its own dependencies.
+		WorkerThreadPool::GroupID empty_group = pool->add_native_group_task(static_dependency_group, nullptr, 0, -1, true, String(), first_deps);
+		WorkerThreadPool::TaskID last_deps[] = { group, empty_group };
+		WorkerThreadPool::TaskID last = pool->add_native_task(static_dependency_last, nullptr, Math::rand() % 2, String(), last_deps);
+
+		CHECK(pool->wait_for_task_completion(last) == OK);
+		CHECK(dependency_stage.get() == 2);
+		CHECK_FALSE(dependency_order_broken.is_set());
+
+		pool->wait_for_task_completion(first);
+		pool->wait_for_group_task_completion(group);
+		pool->wait_for_group_task_completion(empty_group);
+	}
+}
+
 } // namespace TestWorkerThreadPool
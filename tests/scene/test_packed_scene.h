@@ -30,6 +30,9 @@
 
 #pragma once
 
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -280,4 +283,140 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+TEST_CASE("[PackedScene] Repeated instantiation reuses resolved setters") {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+	scene->set_position(Vector2(10, 20));
+	scene->set_z_index(3);
+
+	Node2D *child = memnew(Node2D);
+	child->set_name("Child");
+	child->set_rotation(1.5);
+	child->set_visible(false);
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(scene) == OK);
+
+	for (int i = 0; i < 3; i++) {
+		Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_position() == Vector2(10, 20));
+		CHECK(instance->get_z_index() == 3);
+
+		Node2D *instance_child = Object::cast_to<Node2D>(instance->get_node(NodePath("Child")));
+		REQUIRE(instance_child != nullptr);
+		CHECK(instance_child->get_rotation() == doctest::Approx(1.5));
+		CHECK_FALSE(instance_child->is_visible());
+		memdelete(instance);
+	}
+
+	SUBCASE("Repacking discards the previous plan") {
+		scene->set_position(Vector2(-5, 7));
+		child->set_visible(true);
+		CHECK(packed_scene->pack(scene) == OK);
+
+		Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate());
+		REQUIRE(instance != nullptr);
+		CHECK(instance->get_position() == Vector2(-5, 7));
+		CHECK(Object::cast_to<Node2D>(instance->get_node(NodePath("Child")))->is_visible());
+		memdelete(instance);
+	}
+
+	memdelete(scene);
+}
+
+TEST_CASE("[PackedScene] Pooled instances") {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("Pickup");
+	scene->set_position(Vector2(1, 2));
+	Node2D *child = memnew(Node2D);
+	child->set_name("Sprite");
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(scene) == OK);
+	memdelete(scene);
+
+	Node2D *instance = Object::cast_to<Node2D>(packed_scene->instantiate_pooled());
+	REQUIRE(instance != nullptr);
+	CHECK(packed_scene->get_pooled_count() == 0);
+
+	SUBCASE("Released instances are reset and reused") {
+		Node *parent = memnew(Node);
+		parent->add_child(instance);
+		instance->set_position(Vector2(50, 60));
+		Object::cast_to<Node2D>(instance->get_child(0))->set_visible(false);
+
+		packed_scene->release_pooled(instance);
+		CHECK(instance->get_parent() == nullptr);
+		CHECK(packed_scene->get_pooled_count() == 1);
+
+		Node2D *reused = Object::cast_to<Node2D>(packed_scene->instantiate_pooled());
+		CHECK(reused == instance);
+		CHECK(reused->get_position() == Vector2(1, 2));
+		CHECK(Object::cast_to<Node2D>(reused->get_child(0))->is_visible());
+		CHECK(packed_scene->get_pooled_count() == 0);
+
+		memdelete(reused);
+		memdelete(parent);
+	}
+
+	SUBCASE("Instances with a changed hierarchy are not reused") {
+		instance->add_child(memnew(Node));
+		packed_scene->release_pooled(instance);
+		CHECK(packed_scene->get_pooled_count() == 0);
+	}
+
+	SUBCASE("Prewarming fills the pool") {
+		memdelete(instance);
+		packed_scene->prewarm_pool(4);
+		const uint64_t begin = OS::get_singleton()->get_ticks_msec();
+		while (packed_scene->get_pooled_count() < 4 && OS::get_singleton()->get_ticks_msec() - begin < 5000) {
+			OS::get_singleton()->delay_usec(100);
+		}
+		CHECK(packed_scene->get_pooled_count() == 4);
+
+		packed_scene->clear_pool();
+		CHECK(packed_scene->get_pooled_count() == 0);
+	}
+}
+
+TEST_CASE("[SceneTree][PackedScene] Reused pooled instances receive ready again") {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("Pickup");
+	Node2D *child = memnew(Node2D);
+	child->set_name("Sprite");
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	CHECK(packed_scene->pack(scene) == OK);
+	memdelete(scene);
+
+	Node *instance = packed_scene->instantiate_pooled();
+	REQUIRE(instance != nullptr);
+	SceneTree::get_singleton()->get_root()->add_child(instance);
+	CHECK(instance->is_ready());
+	CHECK(instance->get_child(0)->is_ready());
+
+	packed_scene->release_pooled(instance);
+	CHECK(packed_scene->get_pooled_count() == 1);
+	CHECK_FALSE(instance->is_ready());
+	CHECK_FALSE(instance->get_child(0)->is_ready());
+
+	Node *reused = packed_scene->instantiate_pooled();
+	CHECK(reused == instance);
+	SceneTree::get_singleton()->get_root()->add_child(reused);
+	CHECK(reused->is_ready());
+	CHECK(reused->get_child(0)->is_ready());
+
+	memdelete(reused);
+}
+
 } // namespace TestPackedScene
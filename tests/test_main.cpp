@@ -46,6 +46,8 @@
 #include "tests/core/input/test_shortcut.h"
 #include "tests/core/io/test_config_file.h"
 #include "tests/core/io/test_file_access.h"
+#include "tests/core/io/test_file_access_async.h"
+#include "tests/core/io/test_file_access_pack.h"
 #include "tests/core/io/test_http_client.h"
 #include "tests/core/io/test_image.h"
 #include "tests/core/io/test_ip.h"
@@ -53,6 +55,7 @@
 #include "tests/core/io/test_json_native.h"
 #include "tests/core/io/test_logger.h"
 #include "tests/core/io/test_marshalls.h"
+#include "tests/core/io/test_mod_security.h"
 #include "tests/core/io/test_packet_peer.h"
 #include "tests/core/io/test_resource.h"
 #include "tests/core/io/test_resource_uid.h"
@@ -87,18 +90,22 @@
 #include "tests/core/math/test_vector4.h"
 #include "tests/core/math/test_vector4i.h"
 #include "tests/core/object/test_class_db.h"
+#include "tests/core/object/test_message_queue.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
+#include "tests/core/os/test_memory.h"
 #include "tests/core/os/test_os.h"
 #include "tests/core/string/test_fuzzy_search.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_a_hash_map.h"
 #include "tests/core/templates/test_command_queue.h"
 #include "tests/core/templates/test_fixed_vector.h"
+#include "tests/core/templates/test_frame_arena.h"
 #include "tests/core/templates/test_hash_map.h"
 #include "tests/core/templates/test_hash_set.h"
 #include "tests/core/templates/test_list.h"